@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""
+Generates the D-Bus types of the properties of each Exposes record type from
+the schemas, see src/entity_manager/expose_property_types.hpp.
+
+Properties whose type the schema doesn't pin down, e.g. ["string", "number"]
+or a "number" which isn't necessarily whole, are left out and keep being typed
+by their value at runtime.
+
+With --check, the output isn't written but compared with the existing file,
+which fails when the schemas changed without generating it again.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+SCRIPT_NAME = os.path.basename(__file__)
+DEFAULT_SCHEMA_DIR = os.path.join(
+    os.path.dirname(__file__), "..", "schemas"
+)
+DEFAULT_OUTPUT = os.path.join(
+    os.path.dirname(__file__),
+    "..",
+    "src",
+    "entity_manager",
+    "expose_property_types.cpp",
+)
+
+CPP_TYPES = {
+    "string": "PropertyType::string",
+    "bool": "PropertyType::boolean",
+    "uint64": "PropertyType::uint64",
+    "int64": "PropertyType::int64",
+}
+
+
+class Schemas:
+    def __init__(self, directory):
+        self.files = {}
+        for name in os.listdir(directory):
+            if name.endswith(".json"):
+                with open(os.path.join(directory, name)) as f:
+                    self.files[name] = json.load(f)
+
+    def resolve(self, schema, filename):
+        """
+        Follows $ref until reaching a schema without one, returns the schema
+        and the file it is in.
+        """
+        while "$ref" in schema:
+            target, _, pointer = schema["$ref"].partition("#")
+            if target:
+                filename = target
+            schema = self.files[filename]
+            for part in pointer.strip("/").split("/"):
+                if part:
+                    schema = schema[part]
+        return schema, filename
+
+
+def scalar_type(schema):
+    """
+    Returns the D-Bus type of a schema of a single value, or None if its
+    type isn't pinned down.
+    """
+    if isinstance(schema.get("const"), str):
+        return "string"
+    if "enum" in schema and "type" not in schema:
+        if all(isinstance(v, str) for v in schema["enum"]):
+            return "string"
+        return None
+
+    kind = schema.get("type")
+    if kind == "string":
+        return "string"
+    if kind == "boolean":
+        return "bool"
+    if kind == "integer" or (kind == "number" and schema.get("multipleOf") == 1):
+        if schema.get("minimum", -1) >= 0:
+            return "uint64"
+        return "int64"
+    # Other numbers may be whole or not, whole ones are published as integers
+    # as consumers expect, e.g. an EntityId.
+    return None
+
+
+def table(schemas, schema, filename, name, tables):
+    """
+    Adds the table of the properties of an object schema to 'tables' under
+    'name', and those of the objects nested in it, which are published as
+    interfaces of their own.
+    """
+    properties = {}
+    for prop, sub in schema.get("properties", {}).items():
+        sub, subfile = schemas.resolve(sub, filename)
+        array = sub.get("type") == "array"
+        if array:
+            if not isinstance(sub.get("items"), dict):
+                continue
+            sub, subfile = schemas.resolve(sub["items"], subfile)
+
+        if sub.get("type") == "object" or "properties" in sub:
+            table(schemas, sub, subfile, name + "." + prop, tables)
+            continue
+
+        kind = scalar_type(sub)
+        if kind is not None:
+            properties[prop] = (kind, array)
+
+    merge(tables, name, properties)
+
+
+def merge(tables, name, properties):
+    """
+    Record types may be described by several definitions, only properties
+    typed the same by all of them are kept.
+    """
+    if name not in tables:
+        tables[name] = properties
+        return
+    known = tables[name]
+    for prop in list(known):
+        if prop in properties and properties[prop] != known[prop]:
+            del known[prop]
+    for prop, kind in properties.items():
+        if prop not in known:
+            known[prop] = kind
+
+
+def record_types(schema):
+    record_type = schema.get("properties", {}).get("Type", {})
+    if isinstance(record_type.get("const"), str):
+        return [record_type["const"]]
+    return [t for t in record_type.get("enum", []) if isinstance(t, str)]
+
+
+def generate(schemas):
+    tables = {}
+    exposes = schemas.files["exposes_record.json"]
+    for ref in exposes["$defs"]["ConfigSchema"]["oneOf"]:
+        schema, filename = schemas.resolve(ref, "exposes_record.json")
+        for record_type in record_types(schema):
+            table(schemas, schema, filename, record_type, tables)
+
+    return {name: props for name, props in tables.items() if props}
+
+
+def emit(tables):
+    # record types described by the same definition share their tables
+    shared = {}
+    for name in sorted(tables):
+        key = tuple(sorted(tables[name].items()))
+        shared.setdefault(key, len(shared))
+
+    lines = [
+        "// SPDX-License-Identifier: Apache-2.0",
+        "// SPDX-FileCopyrightText: Copyright OpenBMC Authors",
+        "",
+        "// This file is auto-generated. Do not edit manually.",
+        f"// File content generated with {SCRIPT_NAME}",
+        "",
+        '#include "expose_property_types.hpp"',
+        "",
+        "#include <algorithm>",
+        "#include <array>",
+        "#include <functional>",
+        "#include <utility>",
+        "",
+        "namespace dbus_interface",
+        "{",
+        "",
+        "namespace",
+        "{",
+        "",
+    ]
+
+    for properties, index in shared.items():
+        lines.append(
+            f"constexpr std::array<ExposeProperty, {len(properties)}> "
+            f"properties{index}{{{{"
+        )
+        for prop, (kind, array) in properties:
+            lines.append(
+                f'    {{"{prop}", {CPP_TYPES[kind]}, '
+                f"{'true' if array else 'false'}}},"
+            )
+        lines.append("}};")
+        lines.append("")
+
+    lines.append("using ExposeTable =")
+    lines.append(
+        "    std::pair<std::string_view, std::span<const ExposeProperty>>;"
+    )
+    lines.append("")
+    lines.append(
+        f"constexpr std::array<ExposeTable, {len(tables)}> exposeTables{{{{"
+    )
+    for name in sorted(tables):
+        index = shared[tuple(sorted(tables[name].items()))]
+        lines.append(f'    {{"{name}", properties{index}}},')
+    lines.append("}};")
+    lines += [
+        "",
+        "} // namespace",
+        "",
+        "std::span<const ExposeProperty> exposePropertyTypes(std::string_view type)",
+        "{",
+        "    auto found = std::ranges::lower_bound(exposeTables, type, std::less<>{},",
+        "                                          &ExposeTable::first);",
+        "    if (found == exposeTables.end() || found->first != type)",
+        "    {",
+        "        return {};",
+        "    }",
+        "    return found->second;",
+        "}",
+        "",
+        "} // namespace dbus_interface",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--schema-dir", default=DEFAULT_SCHEMA_DIR)
+    parser.add_argument("--output", default=DEFAULT_OUTPUT)
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="fail if the output differs from the existing file",
+    )
+    args = parser.parse_args()
+
+    generated = emit(generate(Schemas(args.schema_dir)))
+    if args.check:
+        with open(args.output) as f:
+            if f.read() != generated:
+                sys.exit(
+                    f"{args.output} is out of date, run {SCRIPT_NAME} again"
+                )
+        return
+
+    with open(args.output, "w") as f:
+        f.write(generated)
+
+
+if __name__ == "__main__":
+    main()
@@ -3,3 +3,4 @@
 set -e
 
 scripts/validate_configs.py -v -k -e test/expected-schema-errors.txt
+scripts/generate_expose_property_types.py --check
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "change_feed.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace dbus_interface
+{
+
+void ChangeFeed::record(ChangeType type, const std::string& path)
+{
+    if (!changes.empty() && changes.back().type == type &&
+        changes.back().path == path)
+    {
+        return;
+    }
+
+    if (changes.size() == capacity)
+    {
+        dropped = changes.front().generation;
+        changes.pop_front();
+    }
+    changes.emplace_back(++current, type, path);
+}
+
+std::optional<std::vector<ChangeFeed::Change>> ChangeFeed::since(
+    uint64_t generation) const
+{
+    if (generation < dropped || generation > current)
+    {
+        return std::nullopt;
+    }
+
+    auto first = std::ranges::upper_bound(changes, generation, std::less<>{},
+                                          &Change::generation);
+    return std::vector<Change>(first, changes.end());
+}
+
+} // namespace dbus_interface
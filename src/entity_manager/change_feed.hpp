@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dbus_interface
+{
+
+enum class ChangeType : uint8_t
+{
+    added,
+    removed,
+    updated,
+};
+
+// The objects of the published configuration which were added, removed or
+// updated, numbered by a generation increasing with every change, for
+// consumers to fetch what changed since they last looked instead of
+// enumerating the configuration again. Only the latest changes are kept.
+// Generations start from a base chosen per run, so that a generation kept
+// from an earlier run isn't mistaken for one of this run.
+class ChangeFeed
+{
+  public:
+    struct Change
+    {
+        uint64_t generation;
+        ChangeType type;
+        std::string path;
+    };
+
+    // @param base  the generation before any change
+    ChangeFeed(size_t capacity, uint64_t base) :
+        capacity(capacity), current(base), dropped(base)
+    {}
+
+    // @brief  records a change of the object at 'path', unless it is the
+    //         same as the last one, e.g. for another interface of the object
+    void record(ChangeType type, const std::string& path);
+
+    // @returns  the generation of the last change, the base before any
+    uint64_t generation() const
+    {
+        return current;
+    }
+
+    // @returns  the changes after 'generation' in the order they were made,
+    //           nullopt if they aren't all kept anymore or 'generation' is
+    //           one this feed didn't reach, e.g. of an earlier run
+    std::optional<std::vector<Change>> since(uint64_t generation) const;
+
+  private:
+    const size_t capacity;
+    uint64_t current;
+    // the generation of the latest change which isn't kept anymore
+    uint64_t dropped;
+    std::deque<Change> changes;
+};
+
+} // namespace dbus_interface
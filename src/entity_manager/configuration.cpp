@@ -115,23 +115,21 @@ void Configuration::loadConfigurations()
 }
 
 // Iterate over new configuration and erase items from old configuration.
-void deriveNewConfiguration(const nlohmann::json& oldConfiguration,
-                            nlohmann::json& newConfiguration)
+nlohmann::json deriveNewConfiguration(
+    const std::flat_set<std::string, std::less<>>& oldRecords,
+    const nlohmann::json& systemConfiguration)
 {
     lg2::debug("deriving new configuration");
 
-    for (auto it = newConfiguration.begin(); it != newConfiguration.end();)
+    nlohmann::json newConfiguration = nlohmann::json::object();
+    for (const auto& [name, record] : systemConfiguration.items())
     {
-        auto findKey = oldConfiguration.find(it.key());
-        if (findKey != oldConfiguration.end())
+        if (!oldRecords.contains(name))
         {
-            it = newConfiguration.erase(it);
-        }
-        else
-        {
-            it++;
+            newConfiguration[name] = record;
         }
     }
+    return newConfiguration;
 }
 
 // validates a given input(configuration) with a given json schema file.
@@ -159,6 +157,8 @@ void Configuration::filterProbeInterfaces()
             it++;
             continue;
         }
+        probeProperties.addTemplates(*it);
+        templatePlans.add(*it);
 
         nlohmann::json probeCommand;
         if ((*findProbe).type() != nlohmann::json::value_t::array)
@@ -191,35 +191,10 @@ void Configuration::filterProbeInterfaces()
             {
                 std::string interface = probe->substr(0, findStart);
                 probeInterfaces.emplace(interface);
+                probeProperties.addProbe(*probe);
             }
         }
         it++;
     }
 }
 
-bool writeJsonFiles(const nlohmann::json& systemConfiguration)
-{
-    if (!EM_CACHE_CONFIGURATION)
-    {
-        return true;
-    }
-
-    std::error_code ec;
-    std::filesystem::create_directory(configurationOutDir, ec);
-    if (ec)
-    {
-        return false;
-    }
-
-    lg2::debug("writing system configuration to {PATH}", "PATH",
-               currentConfiguration);
-
-    std::ofstream output(currentConfiguration);
-    if (!output.good())
-    {
-        return false;
-    }
-    output << systemConfiguration.dump(4);
-    output.close();
-    return true;
-}
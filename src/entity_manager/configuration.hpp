@@ -1,12 +1,15 @@
 #pragma once
 
+#include "property_projection.hpp"
+#include "template_plan.hpp"
+
 #include <nlohmann/json.hpp>
 
+#include <flat_set>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
-constexpr const char* currentConfiguration = "/var/configuration/system.json";
-
 class Configuration
 {
   public:
@@ -14,6 +17,8 @@ class Configuration
         const std::vector<std::filesystem::path>& configurationDirectories,
         const std::filesystem::path& schemaDirectory);
     std::unordered_set<std::string> probeInterfaces;
+    scan::PropertyProjection probeProperties;
+    em_utils::TemplatePlans templatePlans;
     std::vector<nlohmann::json> configurations;
 
     const std::filesystem::path schemaDirectory;
@@ -28,27 +33,13 @@ class Configuration
     std::vector<std::filesystem::path> configurationDirectories;
 };
 
-bool writeJsonFiles(const nlohmann::json& systemConfiguration);
-
-template <typename JsonType>
-bool setJsonFromPointer(const std::string& ptrStr, const JsonType& value,
-                        nlohmann::json& systemConfiguration)
-{
-    try
-    {
-        nlohmann::json::json_pointer ptr(ptrStr);
-        nlohmann::json& ref = systemConfiguration[ptr];
-        ref = value;
-        return true;
-    }
-    catch (const nlohmann::json::out_of_range&)
-    {
-        return false;
-    }
-}
-
-void deriveNewConfiguration(const nlohmann::json& oldConfiguration,
-                            nlohmann::json& newConfiguration);
+// @brief             collects the records a scan added to the system
+//                    configuration
+// @param oldRecords  names of the records before the scan
+// @returns           a copy of the records not in 'oldRecords'
+nlohmann::json deriveNewConfiguration(
+    const std::flat_set<std::string, std::less<>>& oldRecords,
+    const nlohmann::json& systemConfiguration);
 
 bool validateJson(const nlohmann::json& schemaFile,
                   const nlohmann::json& input);
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "configuration_query.hpp"
+
+#include "../dbus_util.hpp"
+#include "utils.hpp"
+
+#include <sdbusplus/message/native_types.hpp>
+
+namespace dbus_interface
+{
+
+ConfigurationQuery::ConfigurationQuery(
+    const nlohmann::json& systemConfiguration) :
+    systemConfiguration(systemConfiguration)
+{}
+
+// @returns  the path of the board of 'record' as it is published, nullopt if
+//           it isn't published
+static std::optional<sdbusplus::object_path> boardPath(
+    const nlohmann::json& record)
+{
+    auto name = record.find("Name");
+    if (name == record.end() || !name->is_string())
+    {
+        return std::nullopt;
+    }
+    std::string boardName = name->get<std::string>();
+
+    std::string boardType = "Chassis";
+    auto type = record.find("Type");
+    if (type != record.end() && type->is_string())
+    {
+        boardType =
+            dbus_util::sanitizeForDBusPathSegment(type->get<std::string>());
+    }
+    return em_utils::buildInventorySystemPath(boardName, boardType);
+}
+
+// @returns  whether 'expose' is an Exposes record of 'type' which is
+//           published
+static bool isPublished(const nlohmann::json& expose, const std::string& type)
+{
+    if (!expose.is_object())
+    {
+        return false; // deleted
+    }
+    auto exposeType = expose.find("Type");
+    auto name = expose.find("Name");
+    auto status = expose.find("Status");
+    return exposeType != expose.end() && *exposeType == type &&
+           name != expose.end() && name->is_string() &&
+           (status == expose.end() || *status != "disabled") &&
+           dbus_util::validateDBusInterfaceSegments(type);
+}
+
+nlohmann::json ConfigurationQuery::find(std::span<const std::string> types,
+                                        uint64_t generation)
+{
+    if (builtGeneration != generation)
+    {
+        build();
+        builtGeneration = generation;
+    }
+
+    nlohmann::json configurations = nlohmann::json::object();
+    for (const std::string& type : types)
+    {
+        auto found = locations.find(type);
+        if (found == locations.end())
+        {
+            continue;
+        }
+
+        std::optional<sdbusplus::object_path> board;
+        const std::string* boardRecord = nullptr;
+        for (const Location& location : found->second)
+        {
+            // The scan changes the configuration before publishing it,
+            // which starts a new generation, the index may be behind a
+            // record removed or instantiated again meanwhile.
+            auto record = systemConfiguration.find(location.record);
+            if (record == systemConfiguration.end())
+            {
+                continue;
+            }
+            if (boardRecord == nullptr || *boardRecord != location.record)
+            {
+                boardRecord = &location.record;
+                board = boardPath(*record);
+            }
+            auto exposes = record->find("Exposes");
+            if (!board || exposes == record->end() || !exposes->is_array() ||
+                location.expose >= exposes->size())
+            {
+                continue;
+            }
+
+            const nlohmann::json& expose = (*exposes)[location.expose];
+            if (!isPublished(expose, type))
+            {
+                continue;
+            }
+            auto name = expose.find("Name");
+            configurations[(*board / dbus_util::sanitizeForDBusPathSegment(
+                                         name->get<std::string>()))
+                               .str] = expose;
+        }
+    }
+    return configurations;
+}
+
+void ConfigurationQuery::build()
+{
+    locations.clear();
+    if (!systemConfiguration.is_object())
+    {
+        return;
+    }
+
+    for (const auto& [recordName, record] : systemConfiguration.items())
+    {
+        auto exposes = record.find("Exposes");
+        if (!record.is_object() || exposes == record.end() ||
+            !exposes->is_array())
+        {
+            continue;
+        }
+        for (size_t i = 0; i < exposes->size(); i++)
+        {
+            const nlohmann::json& expose = (*exposes)[i];
+            if (!expose.is_object())
+            {
+                continue; // deleted
+            }
+            auto type = expose.find("Type");
+            if (type == expose.end() || !type->is_string() ||
+                !isPublished(expose, type->get_ref<const std::string&>()))
+            {
+                continue;
+            }
+            locations[type->get<std::string>()].insert(
+                Location{recordName, i});
+        }
+    }
+}
+
+} // namespace dbus_interface
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+
+namespace dbus_interface
+{
+
+// Answers the queries of consumers for the configuration of the Exposes types
+// they handle, so they don't need to enumerate every published object. The
+// Exposes records are indexed by type, the index is built on the first query
+// after the configuration changed.
+class ConfigurationQuery
+{
+  public:
+    explicit ConfigurationQuery(const nlohmann::json& systemConfiguration);
+
+    // @param types       Exposes types, e.g. "TMP75"
+    // @param generation  identifies the state of the configuration, see
+    //                    ChangeFeed::generation
+    // @returns           object path -> Exposes record, for the records of
+    //                    'types' which are published, i.e. not disabled
+    nlohmann::json find(std::span<const std::string> types,
+                        uint64_t generation);
+
+  private:
+    struct Location
+    {
+        std::string record;
+        size_t expose;
+
+        auto operator<=>(const Location&) const = default;
+    };
+
+    void build();
+
+    const nlohmann::json& systemConfiguration;
+    std::optional<uint64_t> builtGeneration;
+
+    // Exposes type -> locations of the records of that type
+    std::map<std::string, std::set<Location>, std::less<>> locations;
+};
+
+} // namespace dbus_interface
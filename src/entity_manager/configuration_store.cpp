@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "configuration_store.hpp"
+
+#include "record_name.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// bumped whenever the encoding changes, older files are then ignored
+static constexpr uint64_t storeVersion = 1;
+
+// Snapshots and patches are stored as frames: the size of the payload and
+// its hash, 4 and 8 bytes little endian, followed by the payload. A patch is
+// an array of the pointer and the value, or of the pointer alone if the
+// value was removed.
+static constexpr size_t frameHeaderSize = 12;
+
+namespace
+{
+
+uint64_t payloadHash(std::span<const uint8_t> payload)
+{
+    scan::RecordHasher hasher;
+    hasher.update(std::string_view(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const char*>(payload.data()), payload.size()));
+    return hasher.digest();
+}
+
+void appendFrame(std::vector<uint8_t>& data, const nlohmann::json& payload)
+{
+    std::vector<uint8_t> encoded = nlohmann::json::to_cbor(payload);
+    const uint64_t size = encoded.size();
+    const uint64_t hash = payloadHash(encoded);
+    for (size_t i = 0; i < 4; i++)
+    {
+        data.push_back(static_cast<uint8_t>(size >> (8 * i)));
+    }
+    for (size_t i = 0; i < 8; i++)
+    {
+        data.push_back(static_cast<uint8_t>(hash >> (8 * i)));
+    }
+    data.insert(data.end(), encoded.begin(), encoded.end());
+}
+
+// @brief    takes the next frame off 'data'
+// @returns  its payload, or discarded if the frame is torn or corrupt
+nlohmann::json nextFrame(std::span<const uint8_t>& data)
+{
+    if (data.size() < frameHeaderSize)
+    {
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        size |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    for (size_t i = 0; i < 8; i++)
+    {
+        hash |= static_cast<uint64_t>(data[4 + i]) << (8 * i);
+    }
+    if (data.size() - frameHeaderSize < size)
+    {
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+
+    std::span<const uint8_t> payload = data.subspan(frameHeaderSize, size);
+    data = data.subspan(frameHeaderSize + size);
+    if (payloadHash(payload) != hash)
+    {
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+    return nlohmann::json::from_cbor(payload.begin(), payload.end(), true,
+                                     false);
+}
+
+std::optional<std::vector<uint8_t>> readFile(const std::filesystem::path& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input.good())
+    {
+        return std::nullopt;
+    }
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(input)),
+                                std::istreambuf_iterator<char>());
+}
+
+bool writeAll(int fd, std::span<const uint8_t> data)
+{
+    while (!data.empty())
+    {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data = data.subspan(static_cast<size_t>(written));
+    }
+    return true;
+}
+
+// @brief    writes 'data' to 'path' durably, appending or replacing the file
+// @returns  false on error
+bool writeFile(const std::filesystem::path& path, std::span<const uint8_t> data,
+               bool append)
+{
+    int flags = O_WRONLY | O_CLOEXEC;
+    flags |= append ? O_APPEND : (O_CREAT | O_TRUNC);
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    bool written = writeAll(fd, data) && ::fsync(fd) == 0;
+    return ::close(fd) == 0 && written;
+}
+
+// @brief    replaces the file at 'path' with 'data', a crash leaves either
+//           the old or the new file behind
+// @returns  false on error
+bool replaceFile(const std::filesystem::path& path,
+                 std::span<const uint8_t> data)
+{
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    if (!writeFile(tempPath, data, false))
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        return false;
+    }
+
+    // the rename is durable once the directory is
+    int fd = ::open(path.parent_path().c_str(),
+                    O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        ::fsync(fd);
+        ::close(fd);
+    }
+    return true;
+}
+
+// @brief  removes the value at 'pointer' from the object or the array it is
+//         in, if there is one. Throws for the root.
+void removeValue(nlohmann::json& configuration,
+                 const nlohmann::json::json_pointer& pointer)
+{
+    nlohmann::json::json_pointer parentPointer = pointer.parent_pointer();
+    if (!configuration.contains(parentPointer))
+    {
+        return;
+    }
+    nlohmann::json& parent = configuration[parentPointer];
+    const std::string& key = pointer.back();
+    if (parent.is_object())
+    {
+        parent.erase(key);
+        return;
+    }
+    size_t index = 0;
+    auto [end, ec] = std::from_chars(key.data(), key.data() + key.size(),
+                                     index);
+    if (parent.is_array() && ec == std::errc() &&
+        end == key.data() + key.size() && index < parent.size())
+    {
+        parent.erase(index);
+    }
+}
+
+} // namespace
+
+ConfigurationStore::ConfigurationStore(std::filesystem::path snapshotPath,
+                                       std::filesystem::path journalPath) :
+    snapshotPath(std::move(snapshotPath)), journalPath(std::move(journalPath))
+{}
+
+bool ConfigurationStore::writeSnapshot(nlohmann::json configuration)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(snapshotPath.parent_path(), ec);
+
+    const uint64_t next = generation + 1;
+    std::vector<uint8_t> data;
+    appendFrame(data, {{"Version", storeVersion},
+                       {"Generation", next},
+                       {"Configuration", std::move(configuration)}});
+
+    journalStarted = false;
+    if (!replaceFile(snapshotPath, data))
+    {
+        return false;
+    }
+    generation = next;
+
+    // the journal of the previous snapshot no longer applies
+    data.clear();
+    appendFrame(data, {{"Version", storeVersion}, {"Generation", next}});
+    journalStarted = replaceFile(journalPath, data);
+    return true;
+}
+
+bool ConfigurationStore::appendJournal(
+    std::span<const ConfigurationPatch> patches)
+{
+    if (!journalStarted)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    for (const auto& [pointer, value] : patches)
+    {
+        appendFrame(data, value ? nlohmann::json::array({pointer, *value})
+                                : nlohmann::json::array({pointer}));
+    }
+
+    // a torn write would hide the patches appended after it
+    journalStarted = writeFile(journalPath, data, true);
+    return journalStarted;
+}
+
+std::optional<nlohmann::json> ConfigurationStore::load()
+{
+    std::optional<std::vector<uint8_t>> data = readFile(snapshotPath);
+    if (!data)
+    {
+        return std::nullopt;
+    }
+
+    std::span<const uint8_t> remaining(*data);
+    nlohmann::json snapshot = nextFrame(remaining);
+    if (!snapshot.is_object() || snapshot.value("Version", 0U) != storeVersion)
+    {
+        lg2::error("ignoring invalid configuration snapshot {PATH}", "PATH",
+                   snapshotPath);
+        return std::nullopt;
+    }
+    auto found = snapshot.find("Configuration");
+    const uint64_t* snapshotGeneration =
+        snapshot.contains("Generation")
+            ? snapshot["Generation"].get_ptr<const uint64_t*>()
+            : nullptr;
+    if (found == snapshot.end() || snapshotGeneration == nullptr)
+    {
+        lg2::error("ignoring invalid configuration snapshot {PATH}", "PATH",
+                   snapshotPath);
+        return std::nullopt;
+    }
+    generation = *snapshotGeneration;
+    nlohmann::json configuration = std::move(*found);
+
+    data = readFile(journalPath);
+    if (!data)
+    {
+        return configuration;
+    }
+    remaining = *data;
+    nlohmann::json header = nextFrame(remaining);
+    if (!header.is_object() || header.value("Version", 0U) != storeVersion ||
+        header.value("Generation", 0U) != generation)
+    {
+        // started for another snapshot, whose write was interrupted
+        return configuration;
+    }
+
+    size_t replayed = 0;
+    while (!remaining.empty())
+    {
+        nlohmann::json patch = nextFrame(remaining);
+        if (!patch.is_array() || patch.empty() || patch.size() > 2 ||
+            !patch[0].is_string())
+        {
+            lg2::error("ignoring the end of the configuration journal {PATH}",
+                       "PATH", journalPath);
+            break;
+        }
+        try
+        {
+            nlohmann::json::json_pointer pointer(
+                patch[0].get_ref<const std::string&>());
+            if (patch.size() == 2)
+            {
+                configuration[pointer] = std::move(patch[1]);
+            }
+            else
+            {
+                removeValue(configuration, pointer);
+            }
+            replayed++;
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            lg2::error("ignoring configuration patch {POINTER}: {ERR}",
+                       "POINTER", patch[0].get<std::string>(), "ERR", e);
+        }
+    }
+    lg2::debug("replayed {COUNT} configuration patches", "COUNT", replayed);
+    return configuration;
+}
+
+void ConfigurationStore::clear()
+{
+    std::error_code ec;
+    std::filesystem::remove(snapshotPath, ec);
+    std::filesystem::remove(journalPath, ec);
+    journalStarted = false;
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+constexpr const char* configurationSnapshotFile =
+    "/var/configuration/system.cbor";
+constexpr const char* configurationJournalFile =
+    "/var/configuration/system.journal";
+
+// a JSON pointer into the system configuration, and the value there, or
+// nullopt if the value was removed
+using ConfigurationPatch =
+    std::pair<std::string, std::optional<nlohmann::json>>;
+
+// Persists the system configuration as a compact snapshot, and the changes
+// made to it since as a journal of patches appended to it. A crash at any
+// point leaves a usable pair behind: the snapshot is replaced atomically, a
+// journal is only replayed onto the snapshot it was started for, and a torn
+// patch at the end of the journal is ignored.
+class ConfigurationStore
+{
+  public:
+    ConfigurationStore(std::filesystem::path snapshotPath,
+                       std::filesystem::path journalPath);
+
+    // @brief   replaces the snapshot, and starts its journal
+    // @returns false on error
+    bool writeSnapshot(nlohmann::json configuration);
+
+    // @brief   appends patches to the journal of the last snapshot
+    // @returns false on error, or if this store didn't write a snapshot to
+    //          append to. A snapshot has to be written then.
+    bool appendJournal(std::span<const ConfigurationPatch> patches);
+
+    // @returns  the configuration of the snapshot with its journal replayed,
+    //           or nullopt if there is no valid snapshot
+    std::optional<nlohmann::json> load();
+
+    // @brief  removes the snapshot and the journal
+    void clear();
+
+  private:
+    std::filesystem::path snapshotPath;
+    std::filesystem::path journalPath;
+
+    // of the last snapshot loaded or written, tells its journal apart from
+    // the journals of older snapshots
+    uint64_t generation = 0;
+
+    // whether the journal of the last snapshot written can be appended to
+    bool journalStarted = false;
+};
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "configuration_writer.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+// patches appended to the journal before it is compacted into a snapshot
+static constexpr size_t maxJournaled = 1024;
+
+ConfigurationWriter::ConfigurationWriter(
+    boost::asio::io_context& io, const nlohmann::json& systemConfiguration,
+    std::chrono::milliseconds delay, ConfigurationStore* store) :
+    timer(io), systemConfiguration(systemConfiguration), delay(delay),
+    store(store), thread([this]() { run(); })
+{}
+
+ConfigurationWriter::~ConfigurationWriter()
+{
+    flush();
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+}
+
+void ConfigurationWriter::schedule()
+{
+    snapshotScheduled = true;
+    arm();
+}
+
+void ConfigurationWriter::schedule(const std::string& pointer)
+{
+    changedPointers.emplace(pointer);
+    arm();
+}
+
+void ConfigurationWriter::arm()
+{
+    if (store == nullptr)
+    {
+        snapshotScheduled = false;
+        changedPointers.clear();
+        return;
+    }
+    if (scheduled)
+    {
+        return;
+    }
+    scheduled = true;
+
+    // not re-armed by later changes, so a stream of changes is still written
+    // every 'delay'
+    timer.expires_after(delay);
+    timer.async_wait([this](const boost::system::error_code& ec) {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        handOver();
+    });
+}
+
+void ConfigurationWriter::flush()
+{
+    std::unique_lock lock(mutex);
+    // patches which couldn't be appended are written with a snapshot
+    const bool lost = journalFailed && store != nullptr;
+    lock.unlock();
+    if (scheduled || lost)
+    {
+        timer.cancel();
+        handOver();
+    }
+
+    lock.lock();
+    changed.wait(lock, [this]() {
+        return !pendingSnapshot && pendingPatches.empty() && !writing;
+    });
+}
+
+void ConfigurationWriter::handOver()
+{
+    scheduled = false;
+
+    std::unique_lock lock(mutex);
+    if (snapshotScheduled || !snapshotTaken || journalFailed ||
+        journaled + changedPointers.size() > maxJournaled)
+    {
+        lock.unlock();
+        // The copy is what the io context pays for a snapshot, the thread
+        // does the expensive serialization and the flash write.
+        nlohmann::json snapshot = systemConfiguration;
+        lock.lock();
+        pendingSnapshot = std::move(snapshot);
+        pendingPatches.clear();
+        journalFailed = false;
+        snapshotTaken = true;
+        journaled = 0;
+    }
+    else
+    {
+        for (const std::string& pointer : changedPointers)
+        {
+            // a value no longer there was removed, the patch removes it too
+            nlohmann::json::json_pointer ptr(pointer);
+            std::optional<nlohmann::json> value;
+            if (systemConfiguration.contains(ptr))
+            {
+                value = systemConfiguration.at(ptr);
+            }
+            pendingPatches.emplace_back(pointer, std::move(value));
+        }
+        journaled += changedPointers.size();
+    }
+    snapshotScheduled = false;
+    changedPointers.clear();
+    lock.unlock();
+    changed.notify_all();
+}
+
+void ConfigurationWriter::run()
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        changed.wait(lock, [this]() {
+            return pendingSnapshot || !pendingPatches.empty() || stopping;
+        });
+        if (!pendingSnapshot && pendingPatches.empty())
+        {
+            return;
+        }
+
+        std::optional<nlohmann::json> snapshot = std::move(pendingSnapshot);
+        pendingSnapshot.reset();
+        std::vector<ConfigurationPatch> patches = std::move(pendingPatches);
+        pendingPatches.clear();
+        writing = true;
+        lock.unlock();
+
+        bool journalWritten = true;
+        if (snapshot && !store->writeSnapshot(std::move(*snapshot)))
+        {
+            lg2::error("Error writing the configuration snapshot");
+        }
+        if (!patches.empty() && !store->appendJournal(patches))
+        {
+            lg2::error("Error writing the configuration journal");
+            journalWritten = false;
+        }
+
+        lock.lock();
+        writing = false;
+        if (!journalWritten)
+        {
+            journalFailed = true;
+        }
+        changed.notify_all();
+    }
+}
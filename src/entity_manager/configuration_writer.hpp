@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "configuration_store.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <flat_set>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes the system configuration behind the changes made to it. Changes
+// within 'delay' of the first one are written at once, and the file is
+// serialized and written by a thread of its own, so neither the D-Bus
+// callers changing the configuration nor the io context wait for the flash.
+// Changes of single values are appended to the journal of the store, until
+// it is long enough to be compacted into a snapshot.
+class ConfigurationWriter
+{
+  public:
+    // @param systemConfiguration  the configuration to write, only read on
+    //                             the io context
+    // @param store                used by the writer thread, or nullptr if
+    //                             the configuration isn't persisted
+    ConfigurationWriter(boost::asio::io_context& io,
+                        const nlohmann::json& systemConfiguration,
+                        std::chrono::milliseconds delay,
+                        ConfigurationStore* store);
+
+    ConfigurationWriter(const ConfigurationWriter&) = delete;
+    ConfigurationWriter& operator=(const ConfigurationWriter&) = delete;
+    ConfigurationWriter(ConfigurationWriter&&) = delete;
+    ConfigurationWriter& operator=(ConfigurationWriter&&) = delete;
+
+    // flushes
+    ~ConfigurationWriter();
+
+    // @brief  the system configuration changed, it is written after the
+    //         delay unless a write is scheduled already
+    void schedule();
+
+    // @brief          the value at 'pointer' changed, only the value is
+    //                 written
+    // @param pointer  JSON pointer into the system configuration
+    void schedule(const std::string& pointer);
+
+    // @brief  writes a scheduled change now, and waits for the writes in
+    //         progress to finish
+    void flush();
+
+  private:
+    void arm();
+
+    // hands the changes over to the writer thread
+    void handOver();
+
+    void run();
+
+    boost::asio::steady_timer timer;
+    const nlohmann::json& systemConfiguration;
+    const std::chrono::milliseconds delay;
+    ConfigurationStore* const store;
+    bool scheduled = false;
+    bool snapshotScheduled = false;
+    std::flat_set<std::string> changedPointers;
+    // the journal belongs to the snapshot of the store loaded at boot, it
+    // can't be appended to until a snapshot is written
+    bool snapshotTaken = false;
+    // patches handed over since the last snapshot
+    size_t journaled = 0;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    // the latest snapshot not written yet, replaced by newer ones
+    std::optional<nlohmann::json> pendingSnapshot;
+    // patches to append after 'pendingSnapshot'
+    std::vector<ConfigurationPatch> pendingPatches;
+    // the journal couldn't be appended to, the next write is a snapshot
+    bool journalFailed = false;
+    bool writing = false;
+    bool stopping = false;
+    std::thread thread;
+};
@@ -1,30 +1,89 @@
 #include "dbus_interface.hpp"
 
 #include "../dbus_util.hpp"
+#include "expose_property_types.hpp"
 #include "perform_probe.hpp"
 #include "utils.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <flat_map>
 #include <fstream>
+#include <random>
+#include <ranges>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace dbus_interface
 {
 
+// How many changes of the published objects are kept for consumers catching
+// up with them.
+static constexpr size_t changeFeedCapacity = 4096;
+
+// @returns  a random base for the generations of this run, low enough that
+//           they never wrap around
+static uint64_t generationBase()
+{
+    std::random_device random;
+    std::uniform_int_distribution<uint64_t> base(1, uint64_t{1} << 62);
+    return base(random);
+}
+
 EMDBusInterface::EMDBusInterface(boost::asio::io_context& io,
                                  sdbusplus::asio::object_server& objServer,
-                                 const std::filesystem::path& schemaDirectory) :
-    io(io), objServer(objServer), schemaDirectory(schemaDirectory)
+                                 ConfigurationWriter& writer,
+                                 const std::filesystem::path& schemaDirectory,
+                                 std::function<void()>&& changed) :
+    changes(changeFeedCapacity, generationBase()), io(io),
+    objServer(objServer), writer(writer), changed(std::move(changed)),
+    schemaDirectory(schemaDirectory)
 {}
 
+void EMDBusInterface::recordChange(ChangeType type, const std::string& path)
+{
+    const uint64_t before = changes.generation();
+    changes.record(type, path);
+    if (changes.generation() != before && changed)
+    {
+        changed();
+    }
+}
+
+void EMDBusInterface::interfaceAdded(const std::string& path)
+{
+    size_t& count = pathInterfaces[path];
+    count++;
+    recordChange(count == 1 ? ChangeType::added : ChangeType::updated, path);
+}
+
+void EMDBusInterface::interfaceRemoved(const std::string& path)
+{
+    auto found = pathInterfaces.find(path);
+    if (found == pathInterfaces.end())
+    {
+        return;
+    }
+    found->second--;
+    if (found->second != 0)
+    {
+        recordChange(ChangeType::updated, path);
+        return;
+    }
+    pathInterfaces.erase(found);
+    recordChange(ChangeType::removed, path);
+}
+
 void tryIfaceInitialize(std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
 {
     try
     {
-        iface->initialize();
+        // The InterfacesAdded signal already carries every property, don't
+        // follow it with a PropertiesChanged signal per property which wakes
+        // up every consumer of the inventory once more for each of them.
+        iface->initialize(true);
     }
     catch (std::exception& e)
     {
@@ -44,8 +103,20 @@ std::shared_ptr<sdbusplus::asio::dbus_interface>
     // won't be any. For dynamically added interfaces, we check for null so that
     // a constant delete/add will not create a memory leak
 
-    auto ptr = objServer.add_interface(path, interface);
     auto& dataVector = inventory.try_emplace(parent).first->second;
+    auto found = republishing.find(InterfaceKey{path.str, interface});
+    if (found != republishing.end())
+    {
+        std::shared_ptr<sdbusplus::asio::dbus_interface> ptr =
+            std::move(found->second);
+        republishing.erase(found);
+        republished.emplace(ptr.get());
+        dataVector.emplace_back(ptr);
+        return ptr;
+    }
+
+    auto ptr = objServer.add_interface(path, interface);
+    interfaceAdded(path.str);
     if (checkNull)
     {
         auto it = std::find_if(dataVector.begin(), dataVector.end(),
@@ -83,15 +154,114 @@ void EMDBusInterface::createDeleteObjectMethod(
             // todo(james): dig through sdbusplus to find out why we can't
             // delete it in a method call
             boost::asio::post(io, [dbusInterface, this]() mutable {
-                objServer.remove_interface(dbusInterface);
+                removeInterface(dbusInterface);
             });
 
-            if (!writeJsonFiles(systemConfiguration))
+            writer.schedule(jsonPointerPath);
+        });
+}
+
+static size_t combineHash(size_t seed, size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+void EMDBusInterface::beginRepublish(const std::string& board)
+{
+    auto found = inventory.find(board);
+    if (found == inventory.end())
+    {
+        return;
+    }
+    for (const auto& weak : found->second)
+    {
+        std::shared_ptr<sdbusplus::asio::dbus_interface> iface = weak.lock();
+        if (iface)
+        {
+            republishing.emplace(InterfaceKey{iface->get_object_path(),
+                                              iface->get_interface_name()},
+                                 std::move(iface));
+        }
+    }
+    inventory.erase(found);
+}
+
+void EMDBusInterface::endRepublish()
+{
+    for (const auto& [_, iface] : republishing)
+    {
+        removeInterface(iface);
+    }
+    republishing.clear();
+    republished.clear();
+}
+
+bool EMDBusInterface::preparePopulate(
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface, Content content)
+{
+    InterfaceKey key{iface->get_object_path(), iface->get_interface_name()};
+    if (republished.erase(iface.get()) != 0)
+    {
+        auto published = contents.find(key);
+        if (published != contents.end() &&
+            published->second.layout == content.layout)
+        {
+            // The getters read the configuration, which has the new values
+            // already, the properties are updated in place.
+            bool signalled = false;
+            for (const auto& [name, value] : content.values)
             {
-                lg2::error("error setting json file");
-                throw DBusInternalError();
+                auto old = published->second.values.find(name);
+                if (old == published->second.values.end() ||
+                    old->second != value)
+                {
+                    iface->signal_property(name);
+                    signalled = true;
+                }
             }
-        });
+            if (signalled)
+            {
+                recordChange(ChangeType::updated, key.first);
+            }
+            published->second = std::move(content);
+            return false;
+        }
+
+        // The members of the interface changed, it is replaced by a new
+        // one.
+        std::shared_ptr<sdbusplus::asio::dbus_interface> replacement =
+            objServer.add_interface(key.first, key.second);
+        for (auto& dataVector : inventory | std::views::values)
+        {
+            std::ranges::replace_if(
+                dataVector,
+                [&iface](const auto& weak) { return weak.lock() == iface; },
+                replacement);
+        }
+        objServer.remove_interface(iface);
+        iface = std::move(replacement);
+        recordChange(ChangeType::updated, key.first);
+    }
+    contents.insert_or_assign(std::move(key), std::move(content));
+    return true;
+}
+
+void EMDBusInterface::removeInterface(
+    const std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
+{
+    contents.erase(
+        InterfaceKey{iface->get_object_path(), iface->get_interface_name()});
+    if (objServer.remove_interface(iface))
+    {
+        interfaceRemoved(iface->get_object_path());
+    }
+}
+
+void EMDBusInterface::valueSet(const PropertyLocator& locator,
+                               const std::string& path)
+{
+    writer.schedule(locator.pointer());
+    recordChange(ChangeType::updated, path);
 }
 
 static bool checkArrayElementsSameType(nlohmann::json& value)
@@ -141,9 +311,9 @@ static nlohmann::json::value_t getDBusType(
 }
 
 static void populateInterfacePropertyFromJson(
-    nlohmann::json& systemConfiguration, const std::string& path,
-    const std::string& key, const nlohmann::json& value,
-    nlohmann::json::value_t type,
+    nlohmann::json& systemConfiguration, EMDBusInterface& dbus,
+    const PropertyLocator& locator, const std::string& key,
+    const nlohmann::json& value, nlohmann::json::value_t type,
     std::shared_ptr<sdbusplus::asio::dbus_interface>& iface,
     sdbusplus::asio::PropertyPermission permission)
 {
@@ -154,31 +324,31 @@ static void populateInterfacePropertyFromJson(
         case (nlohmann::json::value_t::boolean):
         {
             addValueToDBus<bool>(key, value, *iface, permission,
-                                 systemConfiguration, path);
+                                 systemConfiguration, dbus, locator);
             break;
         }
         case (nlohmann::json::value_t::number_integer):
         {
             addValueToDBus<int64_t>(key, value, *iface, permission,
-                                    systemConfiguration, path);
+                                    systemConfiguration, dbus, locator);
             break;
         }
         case (nlohmann::json::value_t::number_unsigned):
         {
             addValueToDBus<uint64_t>(key, value, *iface, permission,
-                                     systemConfiguration, path);
+                                     systemConfiguration, dbus, locator);
             break;
         }
         case (nlohmann::json::value_t::number_float):
         {
             addValueToDBus<double>(key, value, *iface, permission,
-                                   systemConfiguration, path);
+                                   systemConfiguration, dbus, locator);
             break;
         }
         case (nlohmann::json::value_t::string):
         {
             addValueToDBus<std::string>(key, value, *iface, permission,
-                                        systemConfiguration, path);
+                                        systemConfiguration, dbus, locator);
             break;
         }
         default:
@@ -191,12 +361,145 @@ static void populateInterfacePropertyFromJson(
     }
 }
 
+// @returns  the properties the schemas define the type of for the
+//           configuration interface 'interface', empty for other interfaces
+static std::span<const ExposeProperty> schemaPropertyTypes(
+    std::string_view interface)
+{
+    constexpr std::string_view prefix = "xyz.openbmc_project.Configuration.";
+    if (!interface.starts_with(prefix))
+    {
+        return {};
+    }
+    std::string_view type = interface.substr(prefix.size());
+    std::span<const ExposeProperty> properties = exposePropertyTypes(type);
+    if (properties.empty() && type.contains('.'))
+    {
+        // the objects of an array are numbered, e.g. Thresholds0
+        properties = exposePropertyTypes(
+            type.substr(0, type.find_last_not_of("0123456789") + 1));
+    }
+    return properties;
+}
+
+static bool matchesPropertyType(const nlohmann::json& value, PropertyType type)
+{
+    switch (type)
+    {
+        case PropertyType::string:
+            return value.is_string();
+        case PropertyType::boolean:
+            return value.is_boolean();
+        case PropertyType::uint64:
+            return value.is_number_unsigned();
+        case PropertyType::int64:
+            return value.is_number_integer();
+    }
+    return false;
+}
+
+// @brief    publishes a property with the type the schema defines for it
+// @returns  false if the value doesn't have that type, then the type is up
+//           to the value
+static bool populateTypedPropertyFromJson(
+    nlohmann::json& systemConfiguration, EMDBusInterface& dbus,
+    const PropertyLocator& locator, const nlohmann::json& value,
+    const ExposeProperty& property,
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface,
+    sdbusplus::asio::PropertyPermission permission)
+{
+    if (value.is_array() != property.array)
+    {
+        return false;
+    }
+    auto matches = [&property](const nlohmann::json& el) {
+        return matchesPropertyType(el, property.type);
+    };
+    if (property.array ? !std::ranges::all_of(value, matches) : !matches(value))
+    {
+        return false;
+    }
+
+    const std::string key(property.name);
+    if (permission == sdbusplus::asio::PropertyPermission::readWrite &&
+        (property.type == PropertyType::uint64 ||
+         property.type == PropertyType::int64))
+    {
+        // setable numbers are doubles, see getDBusType
+        addValueToDBus<double>(key, value, *iface, permission,
+                               systemConfiguration, dbus, locator);
+        return true;
+    }
+
+    switch (property.type)
+    {
+        case PropertyType::string:
+            addValueToDBus<std::string>(key, value, *iface, permission,
+                                        systemConfiguration, dbus, locator);
+            break;
+        case PropertyType::boolean:
+            addValueToDBus<bool>(key, value, *iface, permission,
+                                 systemConfiguration, dbus, locator);
+            break;
+        case PropertyType::uint64:
+            addValueToDBus<uint64_t>(key, value, *iface, permission,
+                                     systemConfiguration, dbus, locator);
+            break;
+        case PropertyType::int64:
+            addValueToDBus<int64_t>(key, value, *iface, permission,
+                                    systemConfiguration, dbus, locator);
+            break;
+    }
+    return true;
+}
+
 // adds simple json types to interface's properties
 void EMDBusInterface::populateInterfaceFromJson(
     nlohmann::json& systemConfiguration, const std::string& jsonPointerPath,
     std::shared_ptr<sdbusplus::asio::dbus_interface>& iface,
     nlohmann::json& dict, sdbusplus::asio::PropertyPermission permission)
 {
+    // The properties and the Delete method refer to the configuration by
+    // the pointer, the D-Bus types of the properties follow from the types
+    // of their values.
+    Content content;
+    content.layout = combineHash(std::hash<std::string>{}(jsonPointerPath),
+                                 static_cast<size_t>(permission));
+    for (const auto& [key, value] : dict.items())
+    {
+        // objects are published as interfaces of their own
+        if (value.is_object() ||
+            (value.is_array() && !value.empty() && value[0].is_object()))
+        {
+            continue;
+        }
+        content.layout =
+            combineHash(content.layout, std::hash<std::string>{}(key));
+        content.layout = combineHash(content.layout,
+                                     static_cast<size_t>(value.type()));
+        if (value.is_array())
+        {
+            for (const nlohmann::json& element : value)
+            {
+                content.layout = combineHash(
+                    content.layout, static_cast<size_t>(element.type()));
+            }
+        }
+        content.values.emplace(key, std::hash<nlohmann::json>{}(value));
+    }
+    if (!preparePopulate(iface, std::move(content)))
+    {
+        return;
+    }
+
+    // the types of the properties of known record types come from the
+    // schemas, so they are the same for every record of the type
+    const std::span<const ExposeProperty> schemaTypes =
+        schemaPropertyTypes(iface->get_interface_name());
+    // the properties are members of the object at 'jsonPointerPath'
+    const std::shared_ptr<const PropertyLocator::Location> object =
+        PropertyLocator::locate(jsonPointerPath);
+
     for (const auto& [key, value] : dict.items())
     {
         auto type = value.type();
@@ -207,22 +510,33 @@ void EMDBusInterface::populateInterfaceFromJson(
                 continue;
             }
             type = value[0].type();
-            if (!checkArrayElementsSameType(value))
-            {
-                lg2::error("dbus format error {VALUE}", "VALUE", value);
-                continue;
-            }
         }
         if (type == nlohmann::json::value_t::object)
         {
             continue; // handled elsewhere
         }
 
-        std::string path = jsonPointerPath;
-        path.append("/").append(key);
+        const PropertyLocator locator(object, key);
 
-        populateInterfacePropertyFromJson(systemConfiguration, path, key, value,
-                                          type, iface, permission);
+        auto schemaType = std::ranges::lower_bound(
+            schemaTypes, key, std::less<>{}, &ExposeProperty::name);
+        if (schemaType != schemaTypes.end() && schemaType->name == key &&
+            populateTypedPropertyFromJson(systemConfiguration, *this,
+                                          locator, value, *schemaType, iface,
+                                          permission))
+        {
+            continue;
+        }
+
+        if (value.is_array() && !checkArrayElementsSameType(value))
+        {
+            lg2::error("dbus format error {VALUE}", "VALUE", value);
+            continue;
+        }
+
+        populateInterfacePropertyFromJson(systemConfiguration, *this,
+                                          locator, key, value, type, iface,
+                                          permission);
     }
     if (permission == sdbusplus::asio::PropertyPermission::readWrite)
     {
@@ -348,10 +662,7 @@ void EMDBusInterface::addObjectJson(
     {
         findExposes->push_back(newData);
     }
-    if (!writeJsonFiles(systemConfiguration))
-    {
-        lg2::error("Error writing json files");
-    }
+    writer.schedule();
 
     std::string dbusName = dbus_util::sanitizeForDBusPathSegment(*name);
 
@@ -373,6 +684,13 @@ void EMDBusInterface::createAddObjectMethod(
 {
     std::shared_ptr<sdbusplus::asio::dbus_interface> iface =
         createInterface(path, "xyz.openbmc_project.AddObject", board);
+    if (!preparePopulate(
+            iface, {combineHash(std::hash<std::string>{}(jsonPointerPath),
+                                std::hash<std::string>{}(board)),
+                    {}}))
+    {
+        return;
+    }
 
     iface->register_method(
         "AddObject",
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "change_feed.hpp"
 #include "configuration.hpp"
+#include "configuration_writer.hpp"
+#include "property_locator.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <nlohmann/json.hpp>
@@ -9,6 +12,10 @@
 #include <sdbusplus/asio/object_server.hpp>
 
 #include <flat_map>
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace dbus_interface
@@ -22,9 +29,13 @@ using JsonVariantType =
 class EMDBusInterface
 {
   public:
+    // @param changed  called whenever a change of the published objects was
+    //                 recorded in 'changes'
     EMDBusInterface(boost::asio::io_context& io,
                     sdbusplus::asio::object_server& objServer,
-                    const std::filesystem::path& schemaDirectory);
+                    ConfigurationWriter& writer,
+                    const std::filesystem::path& schemaDirectory,
+                    std::function<void()>&& changed);
 
     std::shared_ptr<sdbusplus::asio::dbus_interface> createInterface(
         const sdbusplus::object_path& path, const std::string& interface,
@@ -50,7 +61,62 @@ class EMDBusInterface
         const std::shared_ptr<sdbusplus::asio::dbus_interface>& iface,
         nlohmann::json& systemConfiguration);
 
+    // @brief        starts publishing a board again whose record changed.
+    //               Until 'endRepublish', creating an interface the board
+    //               had returns the published one, which is updated in
+    //               place if only its values changed, and only replaced if
+    //               its properties did.
+    // @param board  name the board was published under
+    void beginRepublish(const std::string& board);
+
+    // @brief  removes the interfaces of the republished boards which weren't
+    //         created again
+    void endRepublish();
+
+    // what an interface is populated from
+    struct Content
+    {
+        // hash of what the members of the interface are made from, e.g.
+        // the names and types of its properties
+        size_t layout = 0;
+        // property -> hash of its value, for the properties whose getters
+        // read it from the configuration
+        std::flat_map<std::string, size_t, std::less<>> values;
+    };
+
+    // @brief          prepares an interface to be populated
+    // @param content  what the interface is populated from
+    // @returns        false if 'iface' is a republished interface with the
+    //                 same layout, which is kept as it is. Its properties
+    //                 whose values changed are signalled. Otherwise 'iface'
+    //                 is a new interface to be populated and initialized.
+    bool preparePopulate(
+        std::shared_ptr<sdbusplus::asio::dbus_interface>& iface,
+        Content content);
+
+    void removeInterface(
+        const std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
+
+    // @brief        a published value was set, writes it and records the
+    //               change of the object
+    // @param path   the object the property is published on
+    void valueSet(const PropertyLocator& locator, const std::string& path);
+
+    // the changes of the published objects
+    ChangeFeed changes;
+
   private:
+    // @brief  records a change in 'changes' and tells about it
+    void recordChange(ChangeType type, const std::string& path);
+
+    // @brief  an interface was added at 'path', which is added to the
+    //         published objects if it's the first one there
+    void interfaceAdded(const std::string& path);
+
+    // @brief  an interface was removed from 'path', which is removed from
+    //         the published objects if it was the last one there
+    void interfaceRemoved(const std::string& path);
+
     void addObject(
         const std::flat_map<std::string, JsonVariantType, std::less<>>& data,
         nlohmann::json& systemConfiguration, const std::string& jsonPointerPath,
@@ -65,95 +131,82 @@ class EMDBusInterface
 
     boost::asio::io_context& io;
     sdbusplus::asio::object_server& objServer;
+    ConfigurationWriter& writer;
+    std::function<void()> changed;
+
+    // object path -> number of interfaces published there
+    std::map<std::string, size_t, std::less<>> pathInterfaces;
 
     std::flat_map<std::string,
                   std::vector<std::weak_ptr<sdbusplus::asio::dbus_interface>>,
                   std::less<>>
         inventory;
 
+    // object path, interface name
+    using InterfaceKey = std::pair<std::string, std::string>;
+
+    // what the published interfaces were populated from, see
+    // 'preparePopulate'
+    std::map<InterfaceKey, Content> contents;
+
+    // interfaces of the boards being republished which weren't created again
+    // yet
+    std::map<InterfaceKey, std::shared_ptr<sdbusplus::asio::dbus_interface>>
+        republishing;
+
+    // interfaces taken over from 'republishing'
+    std::set<const sdbusplus::asio::dbus_interface*> republished;
+
     const std::filesystem::path schemaDirectory;
 };
 
 void tryIfaceInitialize(
     std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
 
+// @brief          publishes a property read from and written to the system
+//                 configuration
+// @tparam PropertyType  the D-Bus type of the property, a std::vector for
+//                 arrays
 template <typename PropertyType>
-void addArrayToDbus(const std::string& name, const nlohmann::json& array,
-                    sdbusplus::asio::dbus_interface* iface,
-                    sdbusplus::asio::PropertyPermission permission,
-                    nlohmann::json& systemConfiguration,
-                    const std::string& jsonPointerString)
+void addProperty(const std::string& name,
+                 sdbusplus::asio::dbus_interface* iface,
+                 nlohmann::json& systemConfiguration, EMDBusInterface& dbus,
+                 const PropertyLocator& locator,
+                 sdbusplus::asio::PropertyPermission permission)
 {
-    std::vector<PropertyType> values;
-    for (const auto& property : array)
-    {
-        auto ptr = property.get_ptr<const PropertyType*>();
-        if (ptr != nullptr)
+    auto get = [&systemConfiguration,
+                locator](const PropertyType& removed) -> PropertyType {
+        const nlohmann::json* json = locator.find(systemConfiguration);
+        PropertyType value{};
+        if (json == nullptr || !fromJson(*json, value))
         {
-            values.emplace_back(*ptr);
+            // until the interface is removed with its record
+            return removed;
         }
-    }
-
-    if (permission == sdbusplus::asio::PropertyPermission::readOnly)
-    {
-        iface->register_property(name, values);
-    }
-    else
-    {
-        iface->register_property(
-            name, values,
-            [&systemConfiguration,
-             jsonPointerString{std::string(jsonPointerString)}](
-                const std::vector<PropertyType>& newVal,
-                std::vector<PropertyType>& val) {
-                val = newVal;
-                if (!setJsonFromPointer(jsonPointerString, val,
-                                        systemConfiguration))
-                {
-                    lg2::error("error setting json field");
-                    return -1;
-                }
-                if (!writeJsonFiles(systemConfiguration))
-                {
-                    lg2::error("error setting json file");
-                    return -1;
-                }
-                return 1;
-            });
-    }
-}
+        return value;
+    };
 
-template <typename PropertyType>
-void addProperty(const std::string& name, const PropertyType& value,
-                 sdbusplus::asio::dbus_interface* iface,
-                 nlohmann::json& systemConfiguration,
-                 const std::string& jsonPointerString,
-                 sdbusplus::asio::PropertyPermission permission)
-{
     if (permission == sdbusplus::asio::PropertyPermission::readOnly)
     {
-        iface->register_property(name, value);
+        iface->register_property_r<PropertyType>(
+            name, sdbusplus::vtable::property_::emits_change, std::move(get));
         return;
     }
-    iface->register_property(
-        name, value,
-        [&systemConfiguration,
-         jsonPointerString{std::string(jsonPointerString)}](
-            const PropertyType& newVal, PropertyType& val) {
-            val = newVal;
-            if (!setJsonFromPointer(jsonPointerString, val,
-                                    systemConfiguration))
+    iface->register_property_rw<PropertyType>(
+        name, sdbusplus::vtable::property_::emits_change,
+        [&systemConfiguration, &dbus, iface,
+         locator](const PropertyType& newVal, PropertyType&) {
+            nlohmann::json* json = locator.find(systemConfiguration);
+            if (json == nullptr)
             {
                 lg2::error("error setting json field");
                 return -1;
             }
-            if (!writeJsonFiles(systemConfiguration))
-            {
-                lg2::error("error setting json file");
-                return -1;
-            }
+            *json = newVal;
+            dbus.valueSet(locator, iface->get_object_path());
             return 1;
-        });
+        },
+        std::move(get));
 }
 
 template <typename PropertyType>
@@ -161,17 +214,17 @@ void addValueToDBus(const std::string& key, const nlohmann::json& value,
                     sdbusplus::asio::dbus_interface& iface,
                     sdbusplus::asio::PropertyPermission permission,
                     nlohmann::json& systemConfiguration,
-                    const std::string& path)
+                    EMDBusInterface& dbus, const PropertyLocator& locator)
 {
     if (value.is_array())
     {
-        addArrayToDbus<PropertyType>(key, value, &iface, permission,
-                                     systemConfiguration, path);
+        addProperty<std::vector<PropertyType>>(
+            key, &iface, systemConfiguration, dbus, locator, permission);
     }
     else
     {
-        addProperty(key, value.get<PropertyType>(), &iface, systemConfiguration,
-                    path, permission);
+        addProperty<PropertyType>(key, &iface, systemConfiguration, dbus,
+                                  locator, permission);
     }
 }
 
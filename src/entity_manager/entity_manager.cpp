@@ -7,13 +7,18 @@
 #include "../utils.hpp"
 #include "../variant_visitors.hpp"
 #include "configuration.hpp"
+#include "configuration_query.hpp"
 #include "dbus_interface.hpp"
 #include "log_device_inventory.hpp"
+#include "object_mapper.hpp"
 #include "overlay.hpp"
 #include "perform_scan.hpp"
+#include "publish_priority.hpp"
 #include "topology.hpp"
 #include "utils.hpp"
 
+#include <systemd/sd-bus.h>
+
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
@@ -28,14 +33,41 @@
 #include <xyz/openbmc_project/Inventory/Item/System/common.hpp>
 #include <xyz/openbmc_project/Inventory/Item/common.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <filesystem>
 #include <flat_map>
 #include <fstream>
 #include <functional>
 #include <map>
 #include <regex>
+#include <string_view>
+#include <tuple>
+#include <utility>
 constexpr const char* tempConfigDir = "/tmp/configuration/";
-constexpr const char* lastConfiguration = "/tmp/configuration/last.json";
+constexpr const char* lastSnapshot = "/tmp/configuration/last.cbor";
+constexpr const char* lastJournal = "/tmp/configuration/last.journal";
+// written by earlier versions, replaced by the configuration store
+constexpr const char* legacyConfiguration = "/var/configuration/system.json";
+
+// Delay before scanning after an isolated event, long enough to catch the
+// handful of signals a single hot-plug usually produces.
+static constexpr std::chrono::milliseconds scanQuietDelay(20);
+// Delay used to batch events while a burst is in progress.
+static constexpr std::chrono::milliseconds scanBurstDelay(500);
+// Delay before writing the system configuration after it changed, changes
+// made meanwhile, e.g. by a tool setting many properties, are written with it.
+static constexpr std::chrono::milliseconds configurationWriteDelay(1000);
+// How long records published from the configuration of the previous boot are
+// kept without being found by a scan, long enough for FRUs to be read.
+static constexpr std::chrono::seconds provisionalGracePeriod(60);
+// How long boards are published for before handling other events, the boards
+// the fan and power control depend on are published at once regardless.
+static constexpr std::chrono::milliseconds publishTimeSlice(20);
+// Delay before asking the mapper again about a service which just claimed its
+// name, the mapper introspects it meanwhile.
+static constexpr std::chrono::milliseconds newServiceRecheckDelay(500);
 
 static constexpr std::array<const char*, 6> settableInterfaces = {
     "FanProfile", "Pid", "Pid.Zone", "Stepwise", "Thresholds", "Polling"};
@@ -58,8 +90,16 @@ EntityManager::EntityManager(
     configuration(configurationDirectories, schemaDirectory),
     lastJson(nlohmann::json::object()),
     systemConfiguration(nlohmann::json::object()), io(io),
-    dbus_interface(io, objServer, schemaDirectory), powerStatus(*systemBus),
-    propertiesChangedTimer(io)
+    configurationStore(configurationSnapshotFile, configurationJournalFile),
+    configurationWriter(io, systemConfiguration, configurationWriteDelay,
+                        EM_CACHE_CONFIGURATION ? &configurationStore : nullptr),
+    dbus_interface(io, objServer, configurationWriter, schemaDirectory,
+                   [this]() { generationChanged(); }),
+    configurationQuery(systemConfiguration), powerStatus(*systemBus),
+    propertiesChangedTimer(io),
+    scanCoalescer(scanQuietDelay, scanBurstDelay,
+                  std::chrono::milliseconds(EM_SCAN_MAX_LATENCY_MS)),
+    provisionalTimer(io)
 {
     // All other objects that EntityManager currently support are under the
     // inventory subtree.
@@ -69,36 +109,99 @@ EntityManager::EntityManager(
 
     entityIface = objServer.add_interface(emDbusPath, emDbusName);
     entityIface->register_method("ReScan", [this]() {
+        unscopedScanRequested = true;
         propertiesChangedCallback();
     });
+    entityIface->register_method(
+        "GetConfigurations",
+        [this](const std::vector<std::string>& types, uint64_t generation) {
+            return getConfigurations(types, generation);
+        });
+    entityIface->register_property("CoalescedEvents",
+                                   scanCoalescer.coalescedEvents());
+    entityIface->register_property(
+        "ScanLatencyMs",
+        static_cast<uint64_t>(scanCoalescer.lastLatency().count()));
+    entityIface->register_property("Provisional", provisional);
+    entityIface->register_method(
+        "GetChangesSince",
+        [this](uint64_t generation) { return getChangesSince(generation); });
+    entityIface->register_property("Generation",
+                                   dbus_interface.changes.generation());
+    entityIface->register_property("Settled", settled);
     dbus_interface::tryIfaceInitialize(entityIface);
 
     initFilters(configuration.probeInterfaces);
 }
 
-void EntityManager::postToDbus(const nlohmann::json& newConfiguration)
+void EntityManager::postToDbus(
+    const std::shared_ptr<const nlohmann::json>& newConfiguration,
+    const std::flat_map<std::string, std::string, std::less<>>& changedBoards)
 {
-    std::map<sdbusplus::object_path, std::string> newBoards; // path -> name
+    Publication publication;
+    publication.overlays = newConfiguration;
+    for (const auto& [boardId, _] : newConfiguration->items())
+    {
+        publication.boards.emplace_back(boardId, std::string());
+    }
+    for (const auto& [boardId, publishedName] : changedBoards)
+    {
+        publication.boards.emplace_back(boardId, publishedName);
+    }
 
-    // iterate through boards
-    for (const auto& [boardId, boardConfig] : newConfiguration.items())
+    // the order of the records is kept within a priority
+    auto normal = std::ranges::stable_partition(
+        publication.boards, [this](const auto& board) {
+            auto record = systemConfiguration.find(board.first);
+            return record != systemConfiguration.end() &&
+                   dbus_interface::publishPriority(*record) ==
+                       dbus_interface::PublishPriority::critical;
+        });
+    publication.critical = normal.begin() - publication.boards.begin();
+
+    publications.push_back(std::move(publication));
+    if (publications.size() == 1)
     {
-        const nlohmann::json::object_t* boardConfigPtr =
-            boardConfig.get_ptr<const nlohmann::json::object_t*>();
-        if (boardConfigPtr == nullptr)
+        publishSlice();
+    }
+}
+
+void EntityManager::publishSlice()
+{
+    Publication& publication = publications.front();
+
+    auto deadline = std::chrono::steady_clock::now() + publishTimeSlice;
+    while (!publication.boards.empty())
+    {
+        if (publication.critical == 0)
         {
-            lg2::error("boardConfig for {BOARD} was not an object", "BOARD",
-                       boardId);
-            continue;
+            queueOverlays(publication);
+        }
+        if (publication.critical == 0 &&
+            std::chrono::steady_clock::now() >= deadline)
+        {
+            // handle what else is waiting before publishing more
+            boost::asio::post(io, [this]() { publishSlice(); });
+            return;
+        }
+
+        auto [boardId, publishedName] = std::move(publication.boards.front());
+        publication.boards.pop_front();
+        publishBoard(boardId, publishedName, publication.newBoards);
+
+        if (publication.critical > 0 && --publication.critical == 0)
+        {
+            // sent out before the other boards are even published
+            systemBus->flush();
         }
-        postBoardToDBus(boardId, *boardConfigPtr, newBoards);
     }
+    queueOverlays(publication);
 
     for (const auto& [assocPath, assocPropValue] :
-         topology.getAssocs(std::views::keys(newBoards)))
+         topology.getAssocs(std::views::keys(publication.newBoards)))
     {
-        auto findBoard = newBoards.find(assocPath);
-        if (findBoard == newBoards.end())
+        auto findBoard = publication.newBoards.find(assocPath);
+        if (findBoard == publication.newBoards.end())
         {
             continue;
         }
@@ -109,9 +212,70 @@ void EntityManager::postToDbus(const nlohmann::json& newConfiguration)
                 interface,
             findBoard->second);
 
+        size_t content = 0;
+        for (const auto& [forward, reverse, endpoint] : assocPropValue)
+        {
+            content = content * 31 + std::hash<std::string>{}(forward);
+            content = content * 31 + std::hash<std::string>{}(reverse);
+            content = content * 31 + std::hash<std::string>{}(endpoint);
+        }
+        if (!dbus_interface.preparePopulate(ifacePtr, {content, {}}))
+        {
+            continue;
+        }
         ifacePtr->register_property("Associations", assocPropValue);
         dbus_interface::tryIfaceInitialize(ifacePtr);
     }
+    dbus_interface.endRepublish();
+
+    publications.pop_front();
+    if (!publications.empty())
+    {
+        boost::asio::post(io, [this]() { publishSlice(); });
+    }
+    updateSettled();
+}
+
+void EntityManager::queueOverlays(Publication& publication)
+{
+    if (!publication.overlays)
+    {
+        return;
+    }
+    // a step of its own rather than delaying the boards published next
+    boost::asio::post(io, [this, overlays = std::move(publication.overlays)]() {
+        loadOverlays(*overlays, io);
+    });
+}
+
+void EntityManager::publishBoard(
+    const std::string& boardId, const std::string& publishedName,
+    std::map<sdbusplus::object_path, std::string>& newBoards)
+{
+    auto boardConfig = systemConfiguration.find(boardId);
+    if (boardConfig == systemConfiguration.end())
+    {
+        return;
+    }
+    const nlohmann::json::object_t* boardConfigPtr =
+        boardConfig->get_ptr<const nlohmann::json::object_t*>();
+    if (boardConfigPtr == nullptr)
+    {
+        lg2::error("boardConfig for {BOARD} was not an object", "BOARD",
+                   boardId);
+        return;
+    }
+
+    // The boards of changed records are published like new ones, but keep
+    // the interfaces which come out the same, consumers only see the
+    // interfaces which changed come and go.
+    if (!publishedName.empty())
+    {
+        lg2::debug("republishing {BOARD}", "BOARD", publishedName);
+        dbus_interface.beginRepublish(publishedName);
+        topology.remove(publishedName);
+    }
+    postBoardToDBus(boardId, *boardConfigPtr, newBoards);
 }
 
 void EntityManager::postBoardToDBus(
@@ -296,13 +460,8 @@ void EntityManager::postExposesRecordsToDBus(
 
     for (const auto& [name, config] : item.items())
     {
-        jsonPointerPath = jsonPointerPathBoard;
-        jsonPointerPath.append(std::to_string(exposesIndex))
-            .append("/")
-            .append(name);
-
         if (!postConfigurationRecord(name, config, boardNameOrig, itemType,
-                                     jsonPointerPath, ifacePath))
+                                     jsonPointerPath + "/" + name, ifacePath))
         {
             break;
         }
@@ -313,6 +472,7 @@ void EntityManager::postExposesRecordsToDBus(
             ifacePath, "xyz.openbmc_project.Configuration." + itemType,
             boardNameOrig);
 
+    // the properties are read from the record, not its last member
     dbus_interface.populateInterfaceFromJson(
         systemConfiguration, jsonPointerPath, itemIface, item,
         getPermission(itemType));
@@ -438,11 +598,13 @@ void EntityManager::startRemovedTimer(boost::asio::steady_timer& timer)
     }
 
     timer.expires_after(std::chrono::seconds(10));
+    removedTimerPending = true;
     timer.async_wait([this](const boost::system::error_code& ec) {
         if (ec == boost::asio::error::operation_aborted)
         {
             return;
         }
+        removedTimerPending = false;
 
         bool powerOff = !powerStatus.isPowerOn();
         for (const auto& [name, device] : lastJson.items())
@@ -456,32 +618,59 @@ void EntityManager::startRemovedTimer(boost::asio::steady_timer& timer)
         {
             scannedPowerOn = true;
         }
+        updateSettled();
     });
 }
 
-void EntityManager::pruneConfiguration(bool powerOff, const std::string& name,
-                                       const nlohmann::json& device)
+void EntityManager::pruneConfiguration(bool powerOff, const std::string& name)
 {
     lg2::debug("pruning configuration");
 
-    if (powerOff && deviceRequiresPowerOn(device))
+    auto record = systemConfiguration.find(name);
+    if (record == systemConfiguration.end())
+    {
+        return;
+    }
+    if (powerOff && deviceRequiresPowerOn(*record))
     {
         // power not on yet, don't know if it's there or not
         return;
     }
 
+    // taken out of the configuration, which doesn't need a copy of it
+    nlohmann::json device = std::move(*record);
+    systemConfiguration.erase(record);
+
+    // not to be published by a publication still in progress
+    for (Publication& publication : publications)
+    {
+        auto queued = std::ranges::find(
+            publication.boards, name,
+            &std::pair<std::string, std::string>::first);
+        if (queued == publication.boards.end())
+        {
+            continue;
+        }
+        if (static_cast<size_t>(queued - publication.boards.begin()) <
+            publication.critical)
+        {
+            publication.critical--;
+        }
+        publication.boards.erase(queued);
+    }
+
     auto& ifaces = dbus_interface.getDeviceInterfaces(device);
     for (auto& iface : ifaces)
     {
         auto sharedPtr = iface.lock();
         if (!!sharedPtr)
         {
-            objServer.remove_interface(sharedPtr);
+            dbus_interface.removeInterface(sharedPtr);
         }
     }
 
     ifaces.clear();
-    systemConfiguration.erase(name);
+    recordInputs.remove(name);
     topology.remove(device["Name"].get<std::string>());
     logDeviceRemoved(device);
 }
@@ -495,23 +684,24 @@ void EntityManager::publishNewConfiguration(
     // https://discord.com/channels/775381525260664832/867820390406422538/958048437729910854
     //
     // NOLINTNEXTLINE(performance-unnecessary-value-param)
-    const nlohmann::json newConfiguration)
+    const std::shared_ptr<const nlohmann::json> newConfiguration,
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    const std::shared_ptr<
+        const std::flat_map<std::string, std::string, std::less<>>>
+        changedBoards)
 {
-    loadOverlays(newConfiguration, io);
+    configurationWriter.schedule();
 
-    boost::asio::post(io, [this]() {
-        if (!writeJsonFiles(systemConfiguration))
-        {
-            lg2::error("Error writing json files");
-        }
-    });
-
-    boost::asio::post(io, [this, &instance, count, &timer, newConfiguration]() {
-        postToDbus(newConfiguration);
+    boost::asio::post(io, [this, &instance, count, &timer, newConfiguration,
+                           changedBoards]() {
+        // armed first, the configuration isn't settled before it expires
         if (count == instance)
         {
             startRemovedTimer(timer);
         }
+        postToDbus(newConfiguration, *changedBoards);
+        pendingPublications--;
+        updateSettled();
     });
 }
 
@@ -524,6 +714,7 @@ void EntityManager::propertiesChangedCallbackDebounced(
         // we were cancelled
         return;
     }
+    scanPending = false;
     if (ec)
     {
         lg2::error("async wait error {ERR}", "ERR", ec.message());
@@ -532,55 +723,398 @@ void EntityManager::propertiesChangedCallbackDebounced(
 
     if (propertiesChangedInProgress)
     {
-        propertiesChangedCallback();
+        // the running scan takes care of it, or schedules a new one when done
+        scanChanges.structural = true;
         return;
     }
     propertiesChangedInProgress = true;
 
     lg2::debug("properties changed callback in progress");
 
-    nlohmann::json oldConfiguration = systemConfiguration;
-    auto missingConfigurations = std::make_shared<nlohmann::json>();
-    *missingConfigurations = systemConfiguration;
+    updateScanStatistics(
+        scanCoalescer.scanStarted(std::chrono::steady_clock::now()));
+
+    // New and missing records are told apart by name, the records themselves
+    // are not copied.
+    std::flat_set<std::string, std::less<>> names;
+    for (const auto& [name, _] : systemConfiguration.items())
+    {
+        names.emplace_hint(names.end(), name);
+    }
+    auto missingConfigurations =
+        std::make_shared<std::flat_set<std::string, std::less<>>>(names);
+    if (!scanBase)
+    {
+        scanBase =
+            std::make_shared<const std::flat_set<std::string, std::less<>>>(
+                std::move(names));
+    }
+    // the records a cancelled scan added are still new to this one
+    auto oldRecords = scanBase;
+
+    // On a warm boot the probes are first evaluated against the objects seen
+    // on the previous boot, the scan following right after validates that
+    // against D-Bus.
+    bool speculative = warmSnapshot && !warmStartEvaluated;
+    bool cached =
+        !speculative && onlyServicesRemoved && objectCache.complete();
 
     auto perfScan = std::make_shared<scan::PerformScan>(
         *this, *missingConfigurations, configuration.configurations, io,
-        [this, count, oldConfiguration, missingConfigurations]() {
+        [this, count, oldRecords, missingConfigurations, speculative]() {
             // this is something that since ac has been applied to the
             // bmc we saw, and we no longer see it
             bool powerOff = !powerStatus.isPowerOn();
-            for (const auto& [name, device] : missingConfigurations->items())
+            for (const std::string& name : *missingConfigurations)
+            {
+                if (provisionalRecords.contains(name))
+                {
+                    continue; // until the grace period ends
+                }
+                pruneConfiguration(powerOff, name);
+            }
+            if (!speculative)
             {
-                pruneConfiguration(powerOff, name, device);
+                reconcileProvisional(*missingConfigurations);
             }
-            nlohmann::json newConfiguration = systemConfiguration;
 
-            deriveNewConfiguration(oldConfiguration, newConfiguration);
+            // shared by the steps publishing it rather than copied
+            auto newConfiguration = std::make_shared<const nlohmann::json>(
+                deriveNewConfiguration(*oldRecords, systemConfiguration));
 
-            for (const auto& [_, device] : newConfiguration.items())
+            for (const auto& [_, device] : newConfiguration->items())
             {
                 logDeviceAdded(device);
             }
 
+            // records which were there before and were instantiated again
+            auto changedBoards = std::make_shared<
+                std::flat_map<std::string, std::string, std::less<>>>(
+                std::exchange(replacedRecords, {}));
+            std::erase_if(*changedBoards, [&oldRecords](const auto& item) {
+                return !oldRecords->contains(item.first);
+            });
+
             propertiesChangedInProgress = false;
+            runningScan.reset();
+            scanBase.reset();
+            restartedScans = 0;
 
-            boost::asio::post(io, [this, newConfiguration, count] {
+            if (!takeScanChanges().empty() || speculative)
+            {
+                // changes which arrived too late to be merged into the scan
+                propertiesChangedCallback();
+            }
+            else
+            {
+                onlyServicesRemoved = true;
+            }
+
+            pendingPublications++;
+            boost::asio::post(io, [this, newConfiguration, changedBoards,
+                                   count] {
                 publishNewConfiguration(std::ref(propertiesChangedInstance),
                                         count, std::ref(propertiesChangedTimer),
-                                        newConfiguration);
+                                        newConfiguration, changedBoards);
             });
         });
+    if (speculative)
+    {
+        perfScan->useSnapshot(warmSnapshot);
+        warmStartEvaluated = true;
+    }
+    else if (cached)
+    {
+        lg2::debug("scanning the cached objects of the remaining services");
+        perfScan->useObjectCache();
+    }
+    else if (warmSnapshot)
+    {
+        // validated against the whole tree, once, with every value fetched
+        // since a device may have been replaced by another in the same slot
+        unscopedScanRequested = true;
+        warmSnapshot.reset();
+    }
+    runningScan = perfScan;
     perfScan->run();
 }
 
+void EntityManager::cancelScan()
+{
+    std::shared_ptr<scan::PerformScan> scan = runningScan.lock();
+    if (!scan)
+    {
+        return;
+    }
+    scan->cancel();
+    runningScan.reset();
+    propertiesChangedInProgress = false;
+    // the next scan fetches what changed in the meantime anyway
+    scanChanges = {};
+}
+
+// Bounds how often a scan is restarted in a row, so that objects disappearing
+// all the time cannot keep scans from ever completing.
+static constexpr size_t maxRestartedScans = 3;
+
+void EntityManager::restartScan()
+{
+    if (restartedScans >= maxRestartedScans)
+    {
+        // let the scan complete, and follow it with another one
+        propertiesChangedCallback();
+        return;
+    }
+    restartedScans++;
+
+    lg2::debug("restarting the scan, objects it fetched disappeared");
+    cancelScan();
+    propertiesChangedCallback();
+}
+
+std::tuple<uint64_t, bool, std::string> EntityManager::getConfigurations(
+    const std::vector<std::string>& types, uint64_t generation)
+{
+    const uint64_t current = dbus_interface.changes.generation();
+    if (generation != 0 && generation == current)
+    {
+        return {current, false, std::string()};
+    }
+
+    // FRU data isn't necessarily valid UTF-8
+    return {current, true,
+            configurationQuery.find(types, current)
+                .dump(-1, ' ', false,
+                      nlohmann::json::error_handler_t::replace)};
+}
+
+std::tuple<uint64_t, bool, std::vector<EntityManager::Change>>
+    EntityManager::getChangesSince(uint64_t generation) const
+{
+    const uint64_t current = dbus_interface.changes.generation();
+    std::optional<std::vector<dbus_interface::ChangeFeed::Change>> changes =
+        dbus_interface.changes.since(generation);
+    if (!changes)
+    {
+        return {current, false, {}};
+    }
+
+    std::vector<Change> reply;
+    reply.reserve(changes->size());
+    for (const auto& [changeGeneration, type, path] : *changes)
+    {
+        std::string name;
+        switch (type)
+        {
+            case dbus_interface::ChangeType::added:
+                name = "Added";
+                break;
+            case dbus_interface::ChangeType::removed:
+                name = "Removed";
+                break;
+            case dbus_interface::ChangeType::updated:
+                name = "Updated";
+                break;
+        }
+        reply.emplace_back(changeGeneration, std::move(name), path);
+    }
+    return {current, true, std::move(reply)};
+}
+
+void EntityManager::updateSettled()
+{
+    bool nowSettled = !scanPending && !propertiesChangedInProgress &&
+                      pendingPublications == 0 && publications.empty() &&
+                      !removedTimerPending && !provisional;
+    if (nowSettled != settled)
+    {
+        settled = nowSettled;
+        entityIface->set_property("Settled", settled);
+    }
+}
+
+void EntityManager::generationChanged()
+{
+    // a publication changes many objects at once, signalled once
+    if (generationUpdatePending)
+    {
+        return;
+    }
+    generationUpdatePending = true;
+    boost::asio::post(io, [this]() {
+        generationUpdatePending = false;
+        entityIface->set_property("Generation",
+                                  dbus_interface.changes.generation());
+    });
+}
+
+void EntityManager::updateScanStatistics(std::chrono::milliseconds latency)
+{
+    lg2::debug("scan started {MILLIS}ms after the first pending event",
+               "MILLIS", latency.count());
+
+    entityIface->set_property("CoalescedEvents",
+                              scanCoalescer.coalescedEvents());
+    entityIface->set_property("ScanLatencyMs",
+                              static_cast<uint64_t>(latency.count()));
+}
+
 // main properties changed entry
 void EntityManager::propertiesChangedCallback()
 {
     lg2::debug("properties changed callback");
+    onlyServicesRemoved = false;
+    if (propertiesChangedInProgress)
+    {
+        // merge into the running scan instead of following it with another
+        scanChanges.structural = true;
+        scanCoalescer.eventMerged();
+        return;
+    }
+    scheduleScan(scanCoalescer.eventReceived(std::chrono::steady_clock::now()));
+}
+
+// Check if a PropertiesChanged signal changes a property a probe matches on,
+// or a property a record was templated from, which are then marked stale.
+// Changes of other properties don't alter the outcome of a scan.
+static bool pcChangesInput(sdbusplus::message_t& msg,
+                           const sdbusplus::object_path& path,
+                           const Configuration& configuration,
+                           scan::RecordInputs& recordInputs)
+{
+    sd_bus_message* m = msg.get();
+
+    const char* interface = nullptr;
+    if (sd_bus_message_read_basic(m, 's', &interface) < 0)
+    {
+        lg2::error("malformed PropertiesChanged signal on {PATH}", "PATH",
+                   path);
+        return true;
+    }
+    if (!configuration.probeInterfaces.contains(interface))
+    {
+        // not fetched by scans
+        return false;
+    }
+
+    bool changesInput = false;
+    auto changed = [&](const char* property) {
+        if (configuration.probeProperties.probed(property))
+        {
+            changesInput = true;
+        }
+        if (recordInputs.changed(path.str, interface, property))
+        {
+            changesInput = true;
+        }
+    };
+
+    if (sd_bus_message_enter_container(m, 'a', "{sv}") < 0)
+    {
+        lg2::error("malformed PropertiesChanged signal on {PATH}", "PATH",
+                   path);
+        return true;
+    }
+    int r = 0;
+    while ((r = sd_bus_message_enter_container(m, 'e', "sv")) > 0)
+    {
+        const char* property = nullptr;
+        if (sd_bus_message_read_basic(m, 's', &property) < 0 ||
+            sd_bus_message_skip(m, "v") < 0 ||
+            sd_bus_message_exit_container(m) < 0)
+        {
+            r = -EINVAL;
+            break;
+        }
+        changed(property);
+    }
+    if (r >= 0 && sd_bus_message_exit_container(m) >= 0 &&
+        sd_bus_message_enter_container(m, 'a', "s") >= 0)
+    {
+        // invalidated properties
+        const char* property = nullptr;
+        while ((r = sd_bus_message_read_basic(m, 's', &property)) > 0)
+        {
+            changed(property);
+        }
+    }
+    if (r < 0)
+    {
+        lg2::error("malformed PropertiesChanged signal on {PATH}", "PATH",
+                   path);
+        return true;
+    }
+    return changesInput;
+}
+
+void EntityManager::propertiesChangedCallback(
+    const sdbusplus::object_path& path, sdbusplus::message_t& message)
+{
+    if (!pcChangesInput(message, path, configuration, recordInputs))
+    {
+        // The cached properties are kept as well, so the identity of the
+        // records on the object doesn't churn with them.
+        lg2::debug("ignoring properties changed on {PATH}", "PATH", path);
+        return;
+    }
+
+    objectCache.invalidatePath(path.str);
+    if (propertiesChangedInProgress)
+    {
+        lg2::debug("properties changed on {PATH} during scan", "PATH", path);
+        scanChanges.paths.emplace(path.str);
+        scanCoalescer.eventMerged();
+        return;
+    }
+    propertiesChangedCallback();
+}
+
+scan::ScanChanges EntityManager::takeScanChanges()
+{
+    return std::exchange(scanChanges, {});
+}
+
+// Every so many scans the whole tree is queried, in case probed interfaces
+// appeared somewhere no signal told us about.
+static constexpr size_t unscopedScanInterval = 10;
+
+std::vector<std::string> EntityManager::takeScanQueryRoots()
+{
+    if (probeRoots.empty() || unscopedScanRequested ||
+        scopedScans >= unscopedScanInterval)
+    {
+        unscopedScanRequested = false;
+        return {};
+    }
+    return {probeRoots.begin(), probeRoots.end()};
+}
+
+void EntityManager::learnProbeRoots(const MapperGetSubTreeResponse& objects,
+                                    bool unscoped)
+{
+    if (!unscoped)
+    {
+        // a scoped scan can only find objects under the known roots
+        scopedScans++;
+        return;
+    }
+
+    probeRoots = scan::detail::deriveProbeRoots(objects);
+    scopedScans = 0;
+    lg2::debug("probed interfaces found under {COUNT} path roots", "COUNT",
+               probeRoots.size());
+}
+
+void EntityManager::scheduleScan(std::chrono::milliseconds delay)
+{
     propertiesChangedInstance++;
     size_t count = propertiesChangedInstance;
 
-    propertiesChangedTimer.expires_after(std::chrono::milliseconds(500));
+    // cancels the removed timer sharing it, see publishNewConfiguration
+    propertiesChangedTimer.expires_after(delay);
+    removedTimerPending = false;
+    scanPending = true;
+    updateSettled();
 
     // setup an async wait as we normally get flooded with new requests
     propertiesChangedTimer.async_wait(std::bind_front(
@@ -588,17 +1122,47 @@ void EntityManager::propertiesChangedCallback()
 }
 
 // Check if InterfacesAdded payload contains an iface that needs probing.
+// Only the interface names are decoded, the properties are skipped over
+// without being materialized.
 static bool iaContainsProbeInterface(
     sdbusplus::message_t& msg,
-    const std::unordered_set<std::string>& probeInterfaces)
+    const std::unordered_set<std::string>& probeInterfaces,
+    sdbusplus::object_path& path)
 {
-    sdbusplus::object_path path;
-    DBusObject interfaces;
-    msg.read(path, interfaces);
-    return std::ranges::any_of(interfaces | std::views::keys,
-                               [&probeInterfaces](const auto& ifaceName) {
-                                   return probeInterfaces.contains(ifaceName);
-                               });
+    sd_bus_message* m = msg.get();
+
+    const char* objectPath = nullptr;
+    if (sd_bus_message_read_basic(m, 'o', &objectPath) < 0 ||
+        sd_bus_message_enter_container(m, 'a', "{sa{sv}}") < 0)
+    {
+        lg2::error("malformed InterfacesAdded signal");
+        return false;
+    }
+    path = sdbusplus::object_path(objectPath);
+
+    int r = 0;
+    while ((r = sd_bus_message_enter_container(m, 'e', "sa{sv}")) > 0)
+    {
+        const char* interface = nullptr;
+        if (sd_bus_message_read_basic(m, 's', &interface) < 0)
+        {
+            break;
+        }
+        if (probeInterfaces.contains(interface))
+        {
+            return true;
+        }
+        if (sd_bus_message_skip(m, "a{sv}") < 0 ||
+            sd_bus_message_exit_container(m) < 0)
+        {
+            break;
+        }
+    }
+    if (r < 0)
+    {
+        lg2::error("malformed InterfacesAdded signal on {PATH}", "PATH", path);
+    }
+    return false;
 }
 
 // Check if InterfacesRemoved payload contains an iface that needs probing.
@@ -612,36 +1176,62 @@ static bool irContainsProbeInterface(
                                });
 }
 
+void EntityManager::saveProbeSnapshot(const scan::ProbeSnapshot& snapshot)
+{
+    if (!EM_CACHE_CONFIGURATION)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> data = snapshot.encode();
+    size_t hash = std::hash<std::string_view>{}(std::string_view(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const char*>(data.data()), data.size()));
+    if (hash == savedSnapshotHash)
+    {
+        return;
+    }
+
+    lg2::debug("writing probe snapshot to {PATH}", "PATH", probeSnapshotFile);
+    if (!scan::ProbeSnapshot::save(probeSnapshotFile, data))
+    {
+        lg2::error("Error writing probe snapshot");
+        return;
+    }
+    savedSnapshotHash = hash;
+}
+
 void EntityManager::handleCurrentConfigurationJson()
 {
     if (EM_CACHE_CONFIGURATION && em_utils::fwVersionIsSame())
     {
-        if (std::filesystem::is_regular_file(currentConfiguration))
+        if (auto snapshot = scan::ProbeSnapshot::load(probeSnapshotFile))
         {
-            // this file could just be deleted, but it's nice for debug
-            std::filesystem::create_directory(tempConfigDir);
-            std::filesystem::remove(lastConfiguration);
-            std::filesystem::copy(currentConfiguration, lastConfiguration);
-            std::filesystem::remove(currentConfiguration);
+            lg2::info("starting from the probe snapshot of the previous boot");
+            warmSnapshot = std::make_shared<const scan::ProbeSnapshot>(
+                std::move(*snapshot));
+        }
 
-            std::ifstream jsonStream(lastConfiguration);
-            if (jsonStream.good())
-            {
-                auto data = nlohmann::json::parse(jsonStream, nullptr, false);
-                if (data.is_discarded())
-                {
-                    lg2::error("syntax error in {PATH}", "PATH",
-                               lastConfiguration);
-                }
-                else
-                {
-                    lastJson = std::move(data);
-                }
-            }
-            else
-            {
-                lg2::error("unable to open {PATH}", "PATH", lastConfiguration);
-            }
+        std::optional<nlohmann::json> data = configurationStore.load();
+        if (!data && migrateLegacyConfiguration())
+        {
+            data = configurationStore.load();
+        }
+        if (data)
+        {
+            lastJson = std::move(*data);
+            publishProvisionalConfiguration();
+
+            // these files could just be deleted, but they're nice for debug
+            std::error_code ec;
+            std::filesystem::create_directory(tempConfigDir, ec);
+            std::filesystem::copy(
+                configurationSnapshotFile, lastSnapshot,
+                std::filesystem::copy_options::overwrite_existing, ec);
+            std::filesystem::copy(
+                configurationJournalFile, lastJournal,
+                std::filesystem::copy_options::overwrite_existing, ec);
+            configurationStore.clear();
         }
     }
     else
@@ -649,10 +1239,105 @@ void EntityManager::handleCurrentConfigurationJson()
         // not an error, just logging at this level to make it in the journal
         std::error_code ec;
         lg2::error("Clearing previous configuration");
-        std::filesystem::remove(currentConfiguration, ec);
+        configurationStore.clear();
+        std::filesystem::remove(probeSnapshotFile, ec);
+        std::filesystem::remove(legacyConfiguration, ec);
     }
 }
 
+bool EntityManager::migrateLegacyConfiguration()
+{
+    std::ifstream jsonStream(legacyConfiguration);
+    if (!jsonStream.good())
+    {
+        return false;
+    }
+
+    auto data = nlohmann::json::parse(jsonStream, nullptr, false);
+    std::error_code ec;
+    if (data.is_discarded() || !data.is_object())
+    {
+        lg2::error("syntax error in {PATH}", "PATH", legacyConfiguration);
+        std::filesystem::remove(legacyConfiguration, ec);
+        return false;
+    }
+
+    // removed only once the store has it, to try again on the next boot
+    if (!configurationStore.writeSnapshot(std::move(data)))
+    {
+        lg2::error("unable to migrate {PATH}", "PATH", legacyConfiguration);
+        return false;
+    }
+    lg2::info("migrated {PATH} to the configuration store", "PATH",
+              legacyConfiguration);
+    std::filesystem::remove(legacyConfiguration, ec);
+    return true;
+}
+
+void EntityManager::publishProvisionalConfiguration()
+{
+    if (lastJson.empty() || !systemConfiguration.empty())
+    {
+        return;
+    }
+
+    // On a warm boot the inventory is almost always the same as on the
+    // previous one, consumers can start from it rather than wait for the
+    // scans. The scans then only publish what changed.
+    lg2::info("publishing the configuration of the previous boot");
+    systemConfiguration = lastJson;
+    for (const auto& [name, record] : systemConfiguration.items())
+    {
+        provisionalRecords.emplace_hint(provisionalRecords.end(), name);
+        logDeviceAdded(record);
+    }
+
+    postToDbus(std::make_shared<const nlohmann::json>(systemConfiguration));
+    // persisted again, the store was consumed when loading it
+    configurationWriter.schedule();
+
+    provisional = true;
+    entityIface->set_property("Provisional", provisional);
+
+    provisionalTimer.expires_after(provisionalGracePeriod);
+    provisionalTimer.async_wait([this](const boost::system::error_code& ec) {
+        if (ec == boost::asio::error::operation_aborted ||
+            provisionalRecords.empty())
+        {
+            return;
+        }
+        lg2::info("{COUNT} records of the previous boot weren't found",
+                  "COUNT", provisionalRecords.size());
+        // removed by the next scan unless it finds them
+        provisionalRecords.clear();
+        propertiesChangedCallback();
+    });
+}
+
+void EntityManager::reconcileProvisional(
+    const std::flat_set<std::string, std::less<>>& missingRecords)
+{
+    if (!provisional)
+    {
+        return;
+    }
+
+    // the records the scan found are no longer provisional
+    std::erase_if(provisionalRecords, [&missingRecords](const auto& name) {
+        return !missingRecords.contains(name);
+    });
+    if (!provisionalRecords.empty())
+    {
+        return;
+    }
+
+    lg2::info("the configuration of the previous boot was reconciled");
+    provisionalTimer.cancel();
+    provisional = false;
+    entityIface->set_property("Provisional", provisional);
+    updateSettled();
+}
+
 void EntityManager::registerCallback(const sdbusplus::object_path& path)
 {
     if (dbusMatches.contains(path))
@@ -663,7 +1348,9 @@ void EntityManager::registerCallback(const sdbusplus::object_path& path)
     lg2::debug("creating PropertiesChanged match on {PATH}", "PATH", path);
 
     std::function<void(sdbusplus::message_t & message)> eventHandler =
-        [&](sdbusplus::message_t&) { propertiesChangedCallback(); };
+        [this, path](sdbusplus::message_t& message) {
+            propertiesChangedCallback(path, message);
+        };
 
     sdbusplus::match match(
         static_cast<sdbusplus::bus_t&>(*systemBus),
@@ -672,6 +1359,116 @@ void EntityManager::registerCallback(const sdbusplus::object_path& path)
     dbusMatches.emplace(path, std::move(match));
 }
 
+void EntityManager::serviceRemoved()
+{
+    if (propertiesChangedInProgress)
+    {
+        propertiesChangedCallback();
+        return;
+    }
+    // unlike other changes this one keeps the cache complete, see
+    // onlyServicesRemoved
+    scheduleScan(scanCoalescer.eventReceived(std::chrono::steady_clock::now()));
+}
+
+void EntityManager::checkNewService(
+    const std::string& name,
+    const std::flat_set<std::string, std::less<>>& probeInterfaces,
+    bool retry)
+{
+    // Ask the mapper whether the service provides anything probed, which is
+    // a lot cheaper than a scan fetching the properties of every object. It
+    // is only asked under the roots probed objects were found under, what
+    // the service provides elsewhere is found by the next scan of the whole
+    // tree.
+    std::vector<std::string> roots(probeRoots.begin(), probeRoots.end());
+    if (roots.empty())
+    {
+        roots.emplace_back("/");
+    }
+
+    struct Check
+    {
+        size_t pending;
+        bool found = false;
+        // the mapper failed for one of the roots
+        bool failed = false;
+        // the mapper knew of no probed object under any of the roots
+        bool nothingProbed = true;
+    };
+    auto check = std::make_shared<Check>(roots.size());
+
+    for (const std::string& root : roots)
+    {
+        object_mapper::getSubTree(
+            *systemBus, root, 0, probeInterfaces,
+            [this, check, name, probeInterfaces,
+             retry](boost::system::error_code& ec,
+                    const GetSubTreeType& interfaceSubtree) {
+                if (ec && ec.value() != ENOENT)
+                {
+                    check->failed = true;
+                }
+                else if (!ec)
+                {
+                    check->nothingProbed = false;
+                }
+                for (const auto& [path, object] : interfaceSubtree)
+                {
+                    for (const auto& [service, _] : object)
+                    {
+                        if (service == name)
+                        {
+                            check->found = true;
+                        }
+                    }
+                }
+                if (--check->pending != 0)
+                {
+                    return;
+                }
+
+                if (check->found)
+                {
+                    lg2::debug("{SERVICE} provides probed interfaces",
+                               "SERVICE", name);
+                    propertiesChangedCallback();
+                    return;
+                }
+                if (check->failed)
+                {
+                    // can't tell, better scan
+                    propertiesChangedCallback();
+                    return;
+                }
+
+                // The mapper introspects the service once it claimed its
+                // name, like we were told about it, and may not be done yet.
+                if (retry)
+                {
+                    auto timer =
+                        std::make_shared<boost::asio::steady_timer>(io);
+                    timer->expires_after(newServiceRecheckDelay);
+                    timer->async_wait(
+                        [this, timer, name, probeInterfaces](
+                            const boost::system::error_code& err) {
+                            if (!err)
+                            {
+                                checkNewService(name, probeInterfaces, false);
+                            }
+                        });
+                    return;
+                }
+                if (check->nothingProbed)
+                {
+                    // still no probed object known to the mapper, it may not
+                    // have caught up with the service, better scan
+                    propertiesChangedCallback();
+                }
+            });
+    }
+}
+
 // We need a poke from DBus for static providers that create all their
 // objects prior to claiming a well-known name, and thus don't emit any
 // org.freedesktop.DBus.Properties signals.  Similarly if a process exits
@@ -683,7 +1480,9 @@ void EntityManager::initFilters(
     nameOwnerChangedMatch = std::make_unique<sdbusplus::match>(
         static_cast<sdbusplus::bus_t&>(*systemBus),
         sdbusplus::match_rules::nameOwnerChanged(),
-        [this](sdbusplus::message_t& m) {
+        [this, interfaces = std::flat_set<std::string, std::less<>>(
+                   probeInterfaces.begin(), probeInterfaces.end())](
+            sdbusplus::message_t& m) {
             auto [name, oldOwner,
                   newOwner] = m.unpack<std::string, std::string, std::string>();
 
@@ -693,7 +1492,35 @@ void EntityManager::initFilters(
                 return;
             }
 
-            propertiesChangedCallback();
+            // the service left the bus, or it is another one now
+            bool known = newOwner.empty() ? objectCache.removeService(name)
+                                          : objectCache.invalidateService(name);
+            std::shared_ptr<scan::PerformScan> scan = runningScan.lock();
+            if (!oldOwner.empty() && scan && scan->usesService(name))
+            {
+                // what the running scan fetched from it is gone
+                restartScan();
+                return;
+            }
+            if (newOwner.empty())
+            {
+                // a service we never probed anything from is of no concern
+                if (known)
+                {
+                    serviceRemoved();
+                }
+                return;
+            }
+
+            if (known)
+            {
+                // the service may have created its objects anywhere before
+                // claiming its name, without signalling them
+                unscopedScanRequested = true;
+                propertiesChangedCallback();
+                return;
+            }
+            checkNewService(name, interfaces);
         });
 
     // We also need a poke from DBus when new interfaces are created or
@@ -701,9 +1528,22 @@ void EntityManager::initFilters(
     interfacesAddedMatch = std::make_unique<sdbusplus::match>(
         static_cast<sdbusplus::bus_t&>(*systemBus),
         sdbusplus::match_rules::interfacesAdded(),
-        [this, probeInterfaces](sdbusplus::message_t& msg) {
-            if (iaContainsProbeInterface(msg, probeInterfaces))
+        [this, probeInterfaces,
+         ownName = systemBus->get_unique_name()](sdbusplus::message_t& msg) {
+            if (ownName == msg.get_sender())
             {
+                // our own inventory, never probed
+                return;
+            }
+
+            sdbusplus::object_path path;
+            if (iaContainsProbeInterface(msg, probeInterfaces, path))
+            {
+                objectCache.invalidatePath(path.str);
+                if (!scan::detail::pathUnderRoots(probeRoots, path.str))
+                {
+                    unscopedScanRequested = true;
+                }
                 propertiesChangedCallback();
             }
         });
@@ -719,6 +1559,13 @@ void EntityManager::initFilters(
             {
                 // Clean up match on probe interface removal to avoid leaks
                 dbusMatches.erase(path);
+                objectCache.invalidatePath(path.str);
+                std::shared_ptr<scan::PerformScan> scan = runningScan.lock();
+                if (scan && scan->fetchedInterfaces.contains(path.str))
+                {
+                    restartScan();
+                    return;
+                }
                 propertiesChangedCallback();
             }
         });
@@ -3,17 +3,34 @@
 
 #pragma once
 
+#include "../utils.hpp"
 #include "configuration.hpp"
+#include "configuration_query.hpp"
+#include "configuration_store.hpp"
+#include "configuration_writer.hpp"
 #include "dbus_interface.hpp"
+#include "event_coalescer.hpp"
+#include "object_cache.hpp"
 #include "power_status_monitor.hpp"
+#include "probe_snapshot.hpp"
+#include "record_inputs.hpp"
 #include "topology.hpp"
 
 #include <nlohmann/json.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 
+#include <deque>
 #include <flat_map>
+#include <flat_set>
 #include <string>
+#include <tuple>
+#include <vector>
+
+namespace scan
+{
+struct PerformScan;
+}
 
 class EntityManager
 {
@@ -43,19 +60,71 @@ class EntityManager
     Topology topology;
     boost::asio::io_context& io;
 
+    ConfigurationStore configurationStore;
+    ConfigurationWriter configurationWriter;
+
     dbus_interface::EMDBusInterface dbus_interface;
+    dbus_interface::ConfigurationQuery configurationQuery;
 
     power::PowerStatusMonitor powerStatus;
 
+    scan::ObjectCache objectCache;
+    scan::RecordInputs recordInputs;
+
+    // records the running scan instantiated again -> name of the board they
+    // were published as
+    std::flat_map<std::string, std::string, std::less<>> replacedRecords;
+
     void propertiesChangedCallback();
+    // @brief  properties of the object at 'path' changed, a scan follows if
+    //         a probe or a record may depend on one of them
+    void propertiesChangedCallback(const sdbusplus::object_path& path,
+                                   sdbusplus::message_t& message);
+
+    // @brief    hands the changes seen since the scan started over to it
+    // @returns  the changes, which are then no longer pending
+    scan::ScanChanges takeScanChanges();
+
+    // @brief    picks the object path roots a scan queries the mapper under
+    // @returns  the roots, or none for a query of the whole tree
+    std::vector<std::string> takeScanQueryRoots();
+
+    // @brief           remembers where probed interfaces were found
+    // @param objects   the objects found by a completed scan
+    // @param unscoped  whether the scan queried the whole tree
+    void learnProbeRoots(const MapperGetSubTreeResponse& objects,
+                         bool unscoped);
+
+    // @brief  persists the objects probed by a completed scan, for the next
+    //         boot to start from
+    void saveProbeSnapshot(const scan::ProbeSnapshot& snapshot);
     void propertiesChangedCallbackDebounced(
         size_t count, const boost::system::error_code& ec);
 
     void registerCallback(const sdbusplus::object_path& path);
-    void publishNewConfiguration(const size_t& instance, size_t count,
-                                 boost::asio::steady_timer& timer,
-                                 nlohmann::json newConfiguration);
-    void postToDbus(const nlohmann::json& newConfiguration);
+    void publishNewConfiguration(
+        const size_t& instance, size_t count, boost::asio::steady_timer& timer,
+        std::shared_ptr<const nlohmann::json> newConfiguration,
+        std::shared_ptr<const std::flat_map<std::string, std::string,
+                                            std::less<>>>
+            changedBoards);
+
+    // @brief                publishes the boards of new records, and the
+    //                       boards of changed records again, by priority
+    //                       and after the publications still in progress
+    // @param changedBoards  names of the changed records -> name of the
+    //                       board they were published as. Only their
+    //                       interfaces which changed are updated.
+    void postToDbus(
+        const std::shared_ptr<const nlohmann::json>& newConfiguration,
+        const std::flat_map<std::string, std::string, std::less<>>&
+            changedBoards = {});
+    // @brief                publishes a board of the system configuration
+    // @param publishedName  the name the board was published as if it is
+    //                       published again, otherwise empty
+    void publishBoard(const std::string& boardId,
+                      const std::string& publishedName,
+                      std::map<sdbusplus::object_path, std::string>& newBoards);
     void postBoardToDBus(
         const std::string& boardId, const nlohmann::json::object_t& boardConfig,
         std::map<sdbusplus::object_path, std::string>& newBoards);
@@ -72,11 +141,43 @@ class EntityManager
         const std::string& jsonPointerPath,
         const sdbusplus::object_path& ifacePath);
 
-    void pruneConfiguration(bool powerOff, const std::string& name,
-                            const nlohmann::json& device);
+    // @brief  removes the record 'name' of a device which wasn't found
+    void pruneConfiguration(bool powerOff, const std::string& name);
+
+    // @brief             the GetConfigurations method
+    // @param generation  of the configuration the caller has, or 0
+    // @returns           the current generation, and unless it is
+    //                    'generation', true and the records of 'types' as
+    //                    JSON
+    std::tuple<uint64_t, bool, std::string> getConfigurations(
+        const std::vector<std::string>& types, uint64_t generation);
+
+    // generation, "Added", "Removed" or "Updated", path
+    using Change = std::tuple<uint64_t, std::string, sdbusplus::object_path>;
+
+    // @brief             the GetChangesSince method
+    // @param generation  the caller saw the configuration at
+    // @returns           the current generation, and unless changes after
+    //                    'generation' were dropped already, true and the
+    //                    changes after it
+    std::tuple<uint64_t, bool, std::vector<Change>> getChangesSince(
+        uint64_t generation) const;
 
     void handleCurrentConfigurationJson();
 
+    // @brief  stops the running scan, if any, without completing it
+    void cancelScan();
+
+    // @brief    moves the configuration persisted by versions before the
+    //           configuration store into the store
+    // @returns  whether the store has a snapshot of it now
+    bool migrateLegacyConfiguration();
+
+    // @brief  publishes the configuration of the previous boot before it is
+    //         scanned, the records are provisional until a scan found them
+    //         or the grace period for finding them ended
+    void publishProvisionalConfiguration();
+
   private:
     std::unique_ptr<sdbusplus::match> nameOwnerChangedMatch = nullptr;
     std::unique_ptr<sdbusplus::match> interfacesAddedMatch = nullptr;
@@ -86,8 +187,91 @@ class EntityManager
     bool scannedPowerOn = false;
 
     bool propertiesChangedInProgress = false;
+    std::weak_ptr<scan::PerformScan> runningScan;
+    // records of the system configuration before the running scan, or
+    // before a cancelled one, whose records are still new to the next
+    std::shared_ptr<const std::flat_set<std::string, std::less<>>> scanBase;
+    size_t restartedScans = 0;
     boost::asio::steady_timer propertiesChangedTimer;
     size_t propertiesChangedInstance = 0;
+    scan::EventCoalescer scanCoalescer;
+    scan::ScanChanges scanChanges;
+
+    // roots of the object paths probed interfaces were last found under
+    std::flat_set<std::string, std::less<>> probeRoots;
+    size_t scopedScans = 0;
+    bool unscopedScanRequested = false;
+
+    // whether no scan was requested since the last one completed, but for
+    // services which left the bus. The next scan then evaluates the cached
+    // objects without the ones of these services, instead of asking the
+    // mapper.
+    bool onlyServicesRemoved = false;
+
+    // objects probed on the previous boot, until validated against D-Bus
+    std::shared_ptr<const scan::ProbeSnapshot> warmSnapshot;
+    bool warmStartEvaluated = false;
+    size_t savedSnapshotHash = 0;
+
+    // records published from the configuration of the previous boot which
+    // no scan found yet. They aren't removed before the grace period ends,
+    // in case what they are probed by isn't on D-Bus yet.
+    std::flat_set<std::string, std::less<>> provisionalRecords;
+    bool provisional = false;
+    boost::asio::steady_timer provisionalTimer;
+
+    // @brief  a scan completed, reconciles the provisional records with it
+    void reconcileProvisional(
+        const std::flat_set<std::string, std::less<>>& missingRecords);
+
+    // boards of a 'postToDbus' left to publish, in the order they are
+    // published in
+    struct Publication
+    {
+        // name of the record -> name the board was published as, if it is
+        // published again
+        std::deque<std::pair<std::string, std::string>> boards;
+        // the first boards are critical ones, published before yielding
+        size_t critical = 0;
+        // the configuration whose overlays are loaded once the critical
+        // boards are published, null once they are
+        std::shared_ptr<const nlohmann::json> overlays;
+        // path -> name of the boards published so far
+        std::map<sdbusplus::object_path, std::string> newBoards;
+    };
+    std::deque<Publication> publications;
+    // configurations scanned but not posted for publication yet
+    size_t pendingPublications = 0;
+
+    // the configuration is settled when nothing is about to change it: no
+    // scan is scheduled or running, nothing is left to publish, no removed
+    // board is awaiting its grace period and no record is provisional
+    bool scanPending = false;
+    bool removedTimerPending = false;
+    bool settled = false;
+
+    // @brief  updates the Settled property
+    void updateSettled();
+
+    // @brief  a change of the published objects was recorded, updates the
+    //         Generation property
+    void generationChanged();
+    bool generationUpdatePending = false;
+
+    // @brief  publishes the next boards of the first publication, and
+    //         completes it when there are none left
+    void publishSlice();
+
+    // @brief  loads the overlays of a publication once its critical boards
+    //         are published, unless they are queued already
+    void queueOverlays(Publication& publication);
+
+    void scheduleScan(std::chrono::milliseconds delay);
+
+    // @brief  cancels the running scan, which fetched objects that
+    //         disappeared since, and schedules a new one
+    void restartScan();
+    void updateScanStatistics(std::chrono::milliseconds latency);
 
     std::flat_map<sdbusplus::object_path, sdbusplus::match, std::less<>>
         dbusMatches;
@@ -95,4 +279,17 @@ class EntityManager
     void startRemovedTimer(boost::asio::steady_timer& timer);
 
     void initFilters(const std::unordered_set<std::string>& probeInterfaces);
+
+    // @brief  a service whose objects were cached left the bus, schedules a
+    //         scan without them
+    void serviceRemoved();
+
+    // @brief        scans if the service that just claimed 'name' provides
+    //               any of 'probeInterfaces' under the known probe roots
+    // @param retry  ask the mapper again after a delay if it doesn't know
+    //               about it yet
+    void checkNewService(
+        const std::string& name,
+        const std::flat_set<std::string, std::less<>>& probeInterfaces,
+        bool retry = true);
 };
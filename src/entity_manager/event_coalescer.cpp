@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "event_coalescer.hpp"
+
+#include <algorithm>
+
+namespace scan
+{
+
+EventCoalescer::EventCoalescer(std::chrono::milliseconds quietDelay,
+                               std::chrono::milliseconds burstDelay,
+                               std::chrono::milliseconds maxLatency) :
+    quiet(quietDelay), burst(burstDelay),
+    maxLatency(std::max(maxLatency, quietDelay))
+{}
+
+std::chrono::milliseconds EventCoalescer::eventReceived(Clock::time_point now)
+{
+    // An event is isolated if nothing happened within the last burst window,
+    // anything else is part of a burst and waits for it to settle.
+    std::chrono::milliseconds delay = quiet;
+    if (lastEvent && now - *lastEvent < burst)
+    {
+        delay = burst;
+    }
+    lastEvent = now;
+
+    if (!firstPending)
+    {
+        firstPending = now;
+    }
+    pendingEvents++;
+
+    // never push the scan past the latency bound of the oldest pending event
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        *firstPending + maxLatency - now);
+    return std::clamp(remaining, std::chrono::milliseconds(0), delay);
+}
+
+std::chrono::milliseconds EventCoalescer::scanStarted(Clock::time_point now)
+{
+    if (!firstPending)
+    {
+        // nothing pending, the events were consumed by an earlier scan
+        latency = std::chrono::milliseconds(0);
+        return latency;
+    }
+
+    latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - *firstPending);
+    coalesced += pendingEvents - 1;
+
+    firstPending.reset();
+    pendingEvents = 0;
+    return latency;
+}
+
+} // namespace scan
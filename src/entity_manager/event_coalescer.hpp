@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <flat_set>
+#include <optional>
+#include <string>
+
+namespace scan
+{
+
+// D-Bus changes observed while a scan is running, to be merged into it.
+struct ScanChanges
+{
+    // objects whose properties changed
+    std::flat_set<std::string, std::less<>> paths;
+
+    // objects or services appeared or disappeared, the mapper needs to be
+    // queried again
+    bool structural = false;
+
+    bool empty() const
+    {
+        return paths.empty() && !structural;
+    }
+};
+
+// Decides when to start a scan in response to D-Bus events. An isolated event
+// is acted upon after a short delay, a burst of events is batched into one
+// scan, and no event waits longer than the configured maximum latency.
+class EventCoalescer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    EventCoalescer(std::chrono::milliseconds quietDelay,
+                   std::chrono::milliseconds burstDelay,
+                   std::chrono::milliseconds maxLatency);
+
+    // @brief      records an incoming event
+    // @param now  time of the event
+    // @returns    the delay the scan timer should be (re-)armed with
+    std::chrono::milliseconds eventReceived(Clock::time_point now);
+
+    // @brief      records an event which was merged into the running scan
+    void eventMerged()
+    {
+        coalesced++;
+    }
+
+    // @brief      marks the start of the scan which handles all pending events
+    // @param now  time the scan started
+    // @returns    how long the oldest pending event waited for this scan
+    std::chrono::milliseconds scanStarted(Clock::time_point now);
+
+    // number of events which did not cause a scan of their own
+    uint64_t coalescedEvents() const
+    {
+        return coalesced;
+    }
+
+    // latency of the most recent scan, see 'scanStarted'
+    std::chrono::milliseconds lastLatency() const
+    {
+        return latency;
+    }
+
+  private:
+    std::chrono::milliseconds quiet;
+    std::chrono::milliseconds burst;
+    std::chrono::milliseconds maxLatency;
+
+    std::optional<Clock::time_point> firstPending;
+    std::optional<Clock::time_point> lastEvent;
+    uint64_t pendingEvents = 0;
+
+    uint64_t coalesced = 0;
+    std::chrono::milliseconds latency{0};
+};
+
+} // namespace scan
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "expose_index.hpp"
+
+namespace scan
+{
+
+ExposeIndex::ExposeIndex(const nlohmann::json& systemConfiguration) :
+    systemConfiguration(systemConfiguration)
+{}
+
+void ExposeIndex::invalidate()
+{
+    built = false;
+    locations.clear();
+    recordNames.clear();
+}
+
+void ExposeIndex::recordChanged(const std::string& recordName)
+{
+    if (!built)
+    {
+        return;
+    }
+
+    remove(recordName);
+    auto record = systemConfiguration.find(recordName);
+    if (record != systemConfiguration.end())
+    {
+        add(recordName, *record);
+    }
+}
+
+const std::set<ExposeIndex::Location>& ExposeIndex::find(
+    const std::string& name)
+{
+    static const std::set<Location> none;
+
+    if (!built)
+    {
+        build();
+    }
+    auto found = locations.find(name);
+    return found == locations.end() ? none : found->second;
+}
+
+void ExposeIndex::build()
+{
+    if (systemConfiguration.is_object())
+    {
+        for (const auto& [recordName, record] : systemConfiguration.items())
+        {
+            add(recordName, record);
+        }
+    }
+    built = true;
+}
+
+void ExposeIndex::add(const std::string& recordName,
+                      const nlohmann::json& record)
+{
+    auto exposes = record.find("Exposes");
+    if (!record.is_object() || exposes == record.end() ||
+        !exposes->is_array())
+    {
+        return;
+    }
+
+    std::vector<std::string>& names = recordNames[recordName];
+    for (size_t i = 0; i < exposes->size(); i++)
+    {
+        const nlohmann::json& expose = (*exposes)[i];
+        auto name = expose.find("Name");
+        if (!expose.is_object() || name == expose.end() || !name->is_string())
+        {
+            continue;
+        }
+        names.push_back(name->get<std::string>());
+        locations[names.back()].insert(Location{recordName, i});
+    }
+}
+
+void ExposeIndex::remove(const std::string& recordName)
+{
+    auto names = recordNames.find(recordName);
+    if (names == recordNames.end())
+    {
+        return;
+    }
+
+    for (const std::string& name : names->second)
+    {
+        auto found = locations.find(name);
+        if (found == locations.end())
+        {
+            continue;
+        }
+        std::erase_if(found->second, [&recordName](const Location& location) {
+            return location.record == recordName;
+        });
+        if (found->second.empty())
+        {
+            locations.erase(found);
+        }
+    }
+    recordNames.erase(names);
+}
+
+} // namespace scan
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace scan
+{
+
+// The exposes of the records in the system configuration by their name, so
+// the Bind* and DisableNode expose actions find their targets without
+// walking every record. Built on first use and kept up to date by the scan
+// as it inserts records.
+class ExposeIndex
+{
+  public:
+    struct Location
+    {
+        std::string record;
+        size_t expose;
+
+        auto operator<=>(const Location&) const = default;
+    };
+
+    explicit ExposeIndex(const nlohmann::json& systemConfiguration);
+
+    // @brief  forgets the index, for when the system configuration may have
+    //         changed in ways the scan doesn't track
+    void invalidate();
+
+    // @brief  a record of the system configuration was inserted or replaced
+    void recordChanged(const std::string& recordName);
+
+    // @returns  the locations of the exposes named 'name', in the order they
+    //           appear in the system configuration
+    const std::set<Location>& find(const std::string& name);
+
+  private:
+    void build();
+    void add(const std::string& recordName, const nlohmann::json& record);
+    void remove(const std::string& recordName);
+
+    const nlohmann::json& systemConfiguration;
+    bool built = false;
+
+    // expose name -> locations of the exposes with that name
+    std::map<std::string, std::set<Location>, std::less<>> locations;
+
+    // record name -> names of its exposes
+    std::map<std::string, std::vector<std::string>, std::less<>> recordNames;
+};
+
+} // namespace scan
@@ -0,0 +1,1066 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+// This file is auto-generated. Do not edit manually.
+// File content generated with generate_expose_property_types.py
+
+#include "expose_property_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <utility>
+
+namespace dbus_interface
+{
+
+namespace
+{
+
+constexpr std::array<ExposeProperty, 5> properties0{{
+    {"CPURequired", PropertyType::uint64, false},
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties1{{
+    {"Label", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Polarity", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties2{{
+    {"Direction", PropertyType::string, false},
+    {"Label", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 9> properties3{{
+    {"Address", PropertyType::string, false},
+    {"CPURequired", PropertyType::uint64, false},
+    {"Labels", PropertyType::string, true},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"SlotId", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+    {"fan1_Name", PropertyType::string, false},
+    {"maxiout1_Name", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 1> properties4{{
+    {"Label", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 8> properties5{{
+    {"Address", PropertyType::string, false},
+    {"CPURequired", PropertyType::uint64, false},
+    {"Labels", PropertyType::string, true},
+    {"Name", PropertyType::string, false},
+    {"NameHumidity", PropertyType::string, false},
+    {"NamePressure", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties6{{
+    {"Address", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 1> properties7{{
+    {"CompatibleHardware", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 2> properties8{{
+    {"Name", PropertyType::string, false},
+    {"Polarity", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 2> properties9{{
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties10{{
+    {"Address", PropertyType::string, false},
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties11{{
+    {"Address", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"SerialPort", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 1> properties12{{
+    {"Name", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties13{{
+    {"BindConnector", PropertyType::string, false},
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 2> properties14{{
+    {"LED", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties15{{
+    {"MonitorType", PropertyType::string, false},
+    {"PinName", PropertyType::string, false},
+    {"Polarity", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties16{{
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Sensors", PropertyType::string, true},
+    {"Type", PropertyType::string, false},
+    {"Units", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 6> properties17{{
+    {"Address", PropertyType::string, false},
+    {"Class", PropertyType::string, false},
+    {"GpioPolarity", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Rearm", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties18{{
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+    {"Units", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties19{{
+    {"AllowedFailures", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties20{{
+    {"Name", PropertyType::string, false},
+    {"PresencePinNames", PropertyType::string, true},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 6> properties21{{
+    {"Level", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"PinName", PropertyType::string, false},
+    {"Polarity", PropertyType::string, false},
+    {"SubType", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 7> properties22{{
+    {"CoolantLoopName", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"OpenControlPinName", PropertyType::string, false},
+    {"OpenControlValue", PropertyType::boolean, false},
+    {"OpenPinName", PropertyType::string, false},
+    {"OpenPolarity", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties23{{
+    {"Direction", PropertyType::string, false},
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"Polarity", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties24{{
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 6> properties25{{
+    {"Address", PropertyType::string, false},
+    {"BindConnector", PropertyType::string, false},
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties26{{
+    {"Name", PropertyType::string, false},
+    {"NamedPresenceGpio", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties27{{
+    {"Name", PropertyType::string, false},
+    {"Names", PropertyType::string, true},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties28{{
+    {"LED", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"PwmName", PropertyType::string, false},
+    {"Status", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties29{{
+    {"Address", PropertyType::string, false},
+    {"Class", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties30{{
+    {"Address", PropertyType::string, false},
+    {"Class", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 6> properties31{{
+    {"Address", PropertyType::string, false},
+    {"Class", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"SensorType", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties32{{
+    {"Address", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"PEC", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties33{{
+    {"Index", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties34{{
+    {"Address", PropertyType::string, false},
+    {"ChannelNames", PropertyType::string, true},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties35{{
+    {"Address", PropertyType::string, false},
+    {"FirmwareDevice", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 12> properties36{{
+    {"CheckHysteresisWithSetpoint", PropertyType::boolean, false},
+    {"Class", PropertyType::string, false},
+    {"IgnoreFailIfHostOff", PropertyType::boolean, false},
+    {"InputUnavailableAsFailed", PropertyType::boolean, false},
+    {"Inputs", PropertyType::string, true},
+    {"MissingIsAcceptable", PropertyType::string, true},
+    {"Name", PropertyType::string, false},
+    {"Outputs", PropertyType::string, true},
+    {"Profiles", PropertyType::string, true},
+    {"SetPointOffset", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+    {"Zones", PropertyType::string, true},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties37{{
+    {"AccumulateSetPoint", PropertyType::boolean, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 3> properties38{{
+    {"Name", PropertyType::string, false},
+    {"PortType", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties39{{
+    {"IdlePowerSaverEnabled", PropertyType::boolean, false},
+    {"Name", PropertyType::string, false},
+    {"PowerMode", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties40{{
+    {"AuthType", PropertyType::string, false},
+    {"Hostname", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 4> properties41{{
+    {"Hostname", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"TrustedComponentType", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 9> properties42{{
+    {"Class", PropertyType::string, false},
+    {"IgnoreFailIfHostOff", PropertyType::boolean, false},
+    {"InputUnavailableAsFailed", PropertyType::boolean, false},
+    {"Inputs", PropertyType::string, true},
+    {"MissingIsAcceptable", PropertyType::string, true},
+    {"Name", PropertyType::string, false},
+    {"Profiles", PropertyType::string, true},
+    {"Type", PropertyType::string, false},
+    {"Zones", PropertyType::string, true},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties43{{
+    {"DeviceAddress", PropertyType::string, false},
+    {"DeviceLocation", PropertyType::string, false},
+    {"Mode", PropertyType::string, false},
+    {"Name", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+constexpr std::array<ExposeProperty, 5> properties44{{
+    {"Address", PropertyType::string, false},
+    {"CpuID", PropertyType::uint64, false},
+    {"Name", PropertyType::string, false},
+    {"PowerState", PropertyType::string, false},
+    {"Type", PropertyType::string, false},
+}};
+
+using ExposeTable =
+    std::pair<std::string_view, std::span<const ExposeProperty>>;
+
+constexpr std::array<ExposeTable, 697> exposeTables{{
+    {"ADC", properties0},
+    {"ADC.BridgeGpio", properties1},
+    {"ADC.Thresholds", properties2},
+    {"ADC128D818", properties3},
+    {"ADC128D818.BridgeGpio", properties1},
+    {"ADC128D818.Polling", properties4},
+    {"ADC128D818.Thresholds", properties2},
+    {"ADM1021", properties5},
+    {"ADM1021.Thresholds", properties2},
+    {"ADM1266", properties3},
+    {"ADM1266.BridgeGpio", properties1},
+    {"ADM1266.Polling", properties4},
+    {"ADM1266.Thresholds", properties2},
+    {"ADM1272", properties3},
+    {"ADM1272.BridgeGpio", properties1},
+    {"ADM1272.Polling", properties4},
+    {"ADM1272.Thresholds", properties2},
+    {"ADM1275", properties3},
+    {"ADM1275.BridgeGpio", properties1},
+    {"ADM1275.Polling", properties4},
+    {"ADM1275.Thresholds", properties2},
+    {"ADM1278", properties3},
+    {"ADM1278.BridgeGpio", properties1},
+    {"ADM1278.Polling", properties4},
+    {"ADM1278.Thresholds", properties2},
+    {"ADM1281", properties3},
+    {"ADM1281.BridgeGpio", properties1},
+    {"ADM1281.Polling", properties4},
+    {"ADM1281.Thresholds", properties2},
+    {"ADM1293", properties3},
+    {"ADM1293.BridgeGpio", properties1},
+    {"ADM1293.Polling", properties4},
+    {"ADM1293.Thresholds", properties2},
+    {"ADS1015", properties3},
+    {"ADS1015.BridgeGpio", properties1},
+    {"ADS1015.Polling", properties4},
+    {"ADS1015.Thresholds", properties2},
+    {"ADS7830", properties3},
+    {"ADS7830.BridgeGpio", properties1},
+    {"ADS7830.Polling", properties4},
+    {"ADS7830.Thresholds", properties2},
+    {"ADT7461", properties5},
+    {"ADT7461.Thresholds", properties2},
+    {"AHE50DC_FAN", properties3},
+    {"AHE50DC_FAN.BridgeGpio", properties1},
+    {"AHE50DC_FAN.Polling", properties4},
+    {"AHE50DC_FAN.Thresholds", properties2},
+    {"AlteraMAX10_10M16Firmware", properties6},
+    {"AlteraMAX10_10M16Firmware.FirmwareInfo", properties7},
+    {"AlteraMAX10_10M16Firmware.MuxOutputs", properties8},
+    {"AnalogValve", properties9},
+    {"AnalogValve.FeedbackADC", properties0},
+    {"AnalogValve.FeedbackADC.BridgeGpio", properties1},
+    {"AnalogValve.FeedbackADC.Thresholds", properties2},
+    {"AnalogValve.SetPointDAC", properties10},
+    {"Artesyn7000552480000PowerSupplyUnit", properties11},
+    {"Artesyn7000552480000PowerSupplyUnit.RegisterPollRates", properties12},
+    {"Artesyn7000552480000PowerSupplyUnit.Thresholds", properties2},
+    {"Artesyn7000552531000PowerShelf", properties11},
+    {"Artesyn7000552531000PowerShelf.RegisterPollRates", properties12},
+    {"Artesyn7000552531000PowerShelf.Thresholds", properties2},
+    {"Artesyn7000555240000PowerMonitorModule", properties11},
+    {"Artesyn7000555240000PowerMonitorModule.RegisterPollRates", properties12},
+    {"Artesyn7000555240000PowerMonitorModule.Thresholds", properties2},
+    {"AspeedFan", properties13},
+    {"AspeedFan.Connector", properties14},
+    {"AspeedFan.Presence", properties15},
+    {"AspeedFan.Thresholds", properties2},
+    {"Average", properties16},
+    {"Average.Thresholds", properties2},
+    {"BMC", properties9},
+    {"BMC.FirmwareInfo", properties7},
+    {"BME280", properties5},
+    {"BME280.Thresholds", properties2},
+    {"BMR490", properties3},
+    {"BMR490.BridgeGpio", properties1},
+    {"BMR490.Polling", properties4},
+    {"BMR490.Thresholds", properties2},
+    {"BelimoEV200ARXEValve", properties11},
+    {"BelimoEV200ARXEValve.RegisterPollRates", properties12},
+    {"BelimoEV200ARXEValve.Thresholds", properties2},
+    {"CFMSensor", properties9},
+    {"CRPS185", properties3},
+    {"CRPS185.BridgeGpio", properties1},
+    {"CRPS185.Polling", properties4},
+    {"CRPS185.Thresholds", properties2},
+    {"ChassisIntrusionSensor", properties17},
+    {"DAC", properties10},
+    {"DPS310", properties5},
+    {"DPS310.Thresholds", properties2},
+    {"DPS800", properties3},
+    {"DPS800.BridgeGpio", properties1},
+    {"DPS800.Polling", properties4},
+    {"DPS800.Thresholds", properties2},
+    {"Danfoss003Z8540Valve", properties11},
+    {"Danfoss003Z8540Valve.RegisterPollRates", properties12},
+    {"Danfoss003Z8540Valve.Thresholds", properties2},
+    {"DeltaBBUBC100AE000PowerMonitorModule", properties11},
+    {"DeltaBBUBC100AE000PowerMonitorModule.RegisterPollRates", properties12},
+    {"DeltaBBUBC100AE000PowerMonitorModule.Thresholds", properties2},
+    {"DeltaBBUBS723AE000PowerShelf", properties11},
+    {"DeltaBBUBS723AE000PowerShelf.RegisterPollRates", properties12},
+    {"DeltaBBUBS723AE000PowerShelf.Thresholds", properties2},
+    {"DeltaBBUBU123AE000BatteryBackupUnit", properties11},
+    {"DeltaBBUBU123AE000BatteryBackupUnit.RegisterPollRates", properties12},
+    {"DeltaBBUBU123AE000BatteryBackupUnit.Thresholds", properties2},
+    {"DeltaECD17020037PowerSupplyUnit", properties11},
+    {"DeltaECD17020037PowerSupplyUnit.RegisterPollRates", properties12},
+    {"DeltaECD17020037PowerSupplyUnit.Thresholds", properties2},
+    {"DeltaECD27010006CapacitorBankUnit", properties11},
+    {"DeltaECD27010006CapacitorBankUnit.RegisterPollRates", properties12},
+    {"DeltaECD27010006CapacitorBankUnit.Thresholds", properties2},
+    {"DeltaECD68000047PowerShelf", properties11},
+    {"DeltaECD68000047PowerShelf.RegisterPollRates", properties12},
+    {"DeltaECD68000047PowerShelf.Thresholds", properties2},
+    {"DeltaECD68000049PowerShelf", properties11},
+    {"DeltaECD68000049PowerShelf.RegisterPollRates", properties12},
+    {"DeltaECD68000049PowerShelf.Thresholds", properties2},
+    {"DeltaECD70000017PowerMonitorModule", properties11},
+    {"DeltaECD70000017PowerMonitorModule.RegisterPollRates", properties12},
+    {"DeltaECD70000017PowerMonitorModule.Thresholds", properties2},
+    {"DeltaECD70000020PowerMonitorModule", properties11},
+    {"DeltaECD70000020PowerMonitorModule.RegisterPollRates", properties12},
+    {"DeltaECD70000020PowerMonitorModule.Thresholds", properties2},
+    {"DeltaRDF040DSS5193E0HeatExchanger", properties11},
+    {"DeltaRDF040DSS5193E0HeatExchanger.RegisterPollRates", properties12},
+    {"DeltaRDF040DSS5193E0HeatExchanger.Thresholds", properties2},
+    {"DeltaRDF040DSS5193E0ReservoirPumpUnit", properties11},
+    {"DeltaRDF040DSS5193E0ReservoirPumpUnit.RegisterPollRates", properties12},
+    {"DeltaRDF040DSS5193E0ReservoirPumpUnit.Thresholds", properties2},
+    {"E50SN12051", properties3},
+    {"E50SN12051.BridgeGpio", properties1},
+    {"E50SN12051.Polling", properties4},
+    {"E50SN12051.Thresholds", properties2},
+    {"EEPROM", properties6},
+    {"EEPROM_24C01", properties6},
+    {"EEPROM_24C02", properties6},
+    {"EEPROM_24C04", properties6},
+    {"EEPROM_24C08", properties6},
+    {"EEPROM_24C128", properties6},
+    {"EEPROM_24C16", properties6},
+    {"EEPROM_24C256", properties6},
+    {"EEPROM_24C32", properties6},
+    {"EEPROM_24C64", properties6},
+    {"EMC1403", properties5},
+    {"EMC1403.Thresholds", properties2},
+    {"EMC1412", properties5},
+    {"EMC1412.Thresholds", properties2},
+    {"EMC1413", properties5},
+    {"EMC1413.Thresholds", properties2},
+    {"EMC1414", properties5},
+    {"EMC1414.Thresholds", properties2},
+    {"EmmcDevice", properties9},
+    {"ExitAirTempSensor", properties9},
+    {"ExitAirTempSensor.Thresholds", properties2},
+    {"ExternalSensor", properties18},
+    {"ExternalSensor.Thresholds", properties2},
+    {"FanRedundancy", properties19},
+    {"G751", properties5},
+    {"G751.Thresholds", properties2},
+    {"GPIODeviceDetect", properties20},
+    {"GPIOLeakDetector", properties21},
+    {"GPIOValve", properties22},
+    {"GenericSMBusMux", properties6},
+    {"Gpio", properties23},
+    {"HDC1080", properties5},
+    {"HDC1080.Thresholds", properties2},
+    {"HPEFan", properties24},
+    {"HPEFan.Connector", properties14},
+    {"HPEFan.Presence", properties15},
+    {"HostCpuUtilization", properties9},
+    {"HostCpuUtilization.Polling", properties4},
+    {"HostSPIFlash", properties9},
+    {"HostSPIFlash.FirmwareInfo", properties7},
+    {"HostSPIFlash.MuxOutputs", properties8},
+    {"I2CFan", properties25},
+    {"I2CFan.Connector", properties14},
+    {"I2CFan.Presence", properties15},
+    {"I2CFan.Thresholds", properties2},
+    {"IBMCFFPSConnector", properties26},
+    {"IBMCompatibleSystem", properties27},
+    {"INA219", properties3},
+    {"INA219.BridgeGpio", properties1},
+    {"INA219.Polling", properties4},
+    {"INA219.Thresholds", properties2},
+    {"INA230", properties3},
+    {"INA230.BridgeGpio", properties1},
+    {"INA230.Polling", properties4},
+    {"INA230.Thresholds", properties2},
+    {"INA233", properties3},
+    {"INA233.BridgeGpio", properties1},
+    {"INA233.Polling", properties4},
+    {"INA233.Thresholds", properties2},
+    {"INA238", properties3},
+    {"INA238.BridgeGpio", properties1},
+    {"INA238.Polling", properties4},
+    {"INA238.Thresholds", properties2},
+    {"IPSPS1", properties3},
+    {"IPSPS1.BridgeGpio", properties1},
+    {"IPSPS1.Polling", properties4},
+    {"IPSPS1.Thresholds", properties2},
+    {"IR35221", properties3},
+    {"IR35221.BridgeGpio", properties1},
+    {"IR35221.Polling", properties4},
+    {"IR35221.Thresholds", properties2},
+    {"IR38060", properties3},
+    {"IR38060.BridgeGpio", properties1},
+    {"IR38060.Polling", properties4},
+    {"IR38060.Thresholds", properties2},
+    {"IR38164", properties3},
+    {"IR38164.BridgeGpio", properties1},
+    {"IR38164.Polling", properties4},
+    {"IR38164.Thresholds", properties2},
+    {"IR38263", properties3},
+    {"IR38263.BridgeGpio", properties1},
+    {"IR38263.Polling", properties4},
+    {"IR38263.Thresholds", properties2},
+    {"ISL28022", properties3},
+    {"ISL28022.BridgeGpio", properties1},
+    {"ISL28022.Polling", properties4},
+    {"ISL28022.Thresholds", properties2},
+    {"ISL68137", properties3},
+    {"ISL68137.BridgeGpio", properties1},
+    {"ISL68137.Polling", properties4},
+    {"ISL68137.Thresholds", properties2},
+    {"ISL68220", properties3},
+    {"ISL68220.BridgeGpio", properties1},
+    {"ISL68220.Polling", properties4},
+    {"ISL68220.Thresholds", properties2},
+    {"ISL68223", properties3},
+    {"ISL68223.BridgeGpio", properties1},
+    {"ISL68223.Polling", properties4},
+    {"ISL68223.Thresholds", properties2},
+    {"ISL69225", properties3},
+    {"ISL69225.BridgeGpio", properties1},
+    {"ISL69225.Polling", properties4},
+    {"ISL69225.Thresholds", properties2},
+    {"ISL69243", properties3},
+    {"ISL69243.BridgeGpio", properties1},
+    {"ISL69243.Polling", properties4},
+    {"ISL69243.Thresholds", properties2},
+    {"ISL69260", properties3},
+    {"ISL69260.BridgeGpio", properties1},
+    {"ISL69260.Polling", properties4},
+    {"ISL69260.Thresholds", properties2},
+    {"ISL69269", properties3},
+    {"ISL69269.BridgeGpio", properties1},
+    {"ISL69269.Polling", properties4},
+    {"ISL69269.Thresholds", properties2},
+    {"ISL69269Firmware", properties6},
+    {"ISL69269Firmware.FirmwareInfo", properties7},
+    {"Intel HSBP CPLD", properties6},
+    {"IntelE810SPIFlash", properties9},
+    {"IntelE810SPIFlash.FirmwareInfo", properties7},
+    {"IntelE810SPIFlash.MuxOutputs", properties8},
+    {"IntelFanConnector", properties28},
+    {"IntelHostSPIFlash", properties9},
+    {"IntelHostSPIFlash.FirmwareInfo", properties7},
+    {"IntelHostSPIFlash.MuxOutputs", properties8},
+    {"IntelHsbpFruDevice", properties9},
+    {"IntelHsbpTempSensor", properties9},
+    {"IpmbDevice", properties29},
+    {"IpmbPowerMonitor", properties30},
+    {"IpmbSensor", properties31},
+    {"IpmbSensor.Thresholds", properties2},
+    {"JC42", properties5},
+    {"JC42.Thresholds", properties2},
+    {"LM25066", properties3},
+    {"LM25066.BridgeGpio", properties1},
+    {"LM25066.Polling", properties4},
+    {"LM25066.Thresholds", properties2},
+    {"LM5066I", properties3},
+    {"LM5066I.BridgeGpio", properties1},
+    {"LM5066I.Polling", properties4},
+    {"LM5066I.Thresholds", properties2},
+    {"LM75A", properties5},
+    {"LM75A.Thresholds", properties2},
+    {"LM95234", properties5},
+    {"LM95234.Thresholds", properties2},
+    {"LTC2945", properties3},
+    {"LTC2945.BridgeGpio", properties1},
+    {"LTC2945.Polling", properties4},
+    {"LTC2945.Thresholds", properties2},
+    {"LTC4282", properties3},
+    {"LTC4282.BridgeGpio", properties1},
+    {"LTC4282.Polling", properties4},
+    {"LTC4282.Thresholds", properties2},
+    {"LTC4286", properties3},
+    {"LTC4286.BridgeGpio", properties1},
+    {"LTC4286.Polling", properties4},
+    {"LTC4286.Thresholds", properties2},
+    {"LTC4287", properties3},
+    {"LTC4287.BridgeGpio", properties1},
+    {"LTC4287.Polling", properties4},
+    {"LTC4287.Thresholds", properties2},
+    {"LatticeLCMXO2_4000HCFirmware", properties6},
+    {"LatticeLCMXO2_4000HCFirmware.FirmwareInfo", properties7},
+    {"LatticeLCMXO2_4000HCFirmware.MuxOutputs", properties8},
+    {"LatticeLCMXO3D_4300Firmware", properties6},
+    {"LatticeLCMXO3D_4300Firmware.FirmwareInfo", properties7},
+    {"LatticeLCMXO3D_4300Firmware.MuxOutputs", properties8},
+    {"LatticeLCMXO3D_9400Firmware", properties6},
+    {"LatticeLCMXO3D_9400Firmware.FirmwareInfo", properties7},
+    {"LatticeLCMXO3D_9400Firmware.MuxOutputs", properties8},
+    {"LatticeLCMXO3LF_2100CFirmware", properties6},
+    {"LatticeLCMXO3LF_2100CFirmware.FirmwareInfo", properties7},
+    {"LatticeLCMXO3LF_2100CFirmware.MuxOutputs", properties8},
+    {"LatticeLCMXO3LF_4300CFirmware", properties6},
+    {"LatticeLCMXO3LF_4300CFirmware.FirmwareInfo", properties7},
+    {"LatticeLCMXO3LF_4300CFirmware.MuxOutputs", properties8},
+    {"LatticeLFMXO5_15DFirmware", properties6},
+    {"LatticeLFMXO5_15DFirmware.FirmwareInfo", properties7},
+    {"LatticeLFMXO5_15DFirmware.MuxOutputs", properties8},
+    {"LatticeLFMXO5_25Firmware", properties6},
+    {"LatticeLFMXO5_25Firmware.FirmwareInfo", properties7},
+    {"LatticeLFMXO5_25Firmware.MuxOutputs", properties8},
+    {"LatticeLFMXO5_65TFirmware", properties6},
+    {"LatticeLFMXO5_65TFirmware.FirmwareInfo", properties7},
+    {"LatticeLFMXO5_65TFirmware.MuxOutputs", properties8},
+    {"MAX11607", properties3},
+    {"MAX11607.BridgeGpio", properties1},
+    {"MAX11607.Polling", properties4},
+    {"MAX11607.Thresholds", properties2},
+    {"MAX11615", properties3},
+    {"MAX11615.BridgeGpio", properties1},
+    {"MAX11615.Polling", properties4},
+    {"MAX11615.Thresholds", properties2},
+    {"MAX11617", properties3},
+    {"MAX11617.BridgeGpio", properties1},
+    {"MAX11617.Polling", properties4},
+    {"MAX11617.Thresholds", properties2},
+    {"MAX16601", properties3},
+    {"MAX16601.BridgeGpio", properties1},
+    {"MAX16601.Polling", properties4},
+    {"MAX16601.Thresholds", properties2},
+    {"MAX20710", properties3},
+    {"MAX20710.BridgeGpio", properties1},
+    {"MAX20710.Polling", properties4},
+    {"MAX20710.Thresholds", properties2},
+    {"MAX20730", properties3},
+    {"MAX20730.BridgeGpio", properties1},
+    {"MAX20730.Polling", properties4},
+    {"MAX20730.Thresholds", properties2},
+    {"MAX20734", properties3},
+    {"MAX20734.BridgeGpio", properties1},
+    {"MAX20734.Polling", properties4},
+    {"MAX20734.Thresholds", properties2},
+    {"MAX20796", properties3},
+    {"MAX20796.BridgeGpio", properties1},
+    {"MAX20796.Polling", properties4},
+    {"MAX20796.Thresholds", properties2},
+    {"MAX209XXFirmware", properties6},
+    {"MAX209XXFirmware.FirmwareInfo", properties7},
+    {"MAX31725", properties5},
+    {"MAX31725.Thresholds", properties2},
+    {"MAX31730", properties5},
+    {"MAX31730.Thresholds", properties2},
+    {"MAX34451", properties3},
+    {"MAX34451.BridgeGpio", properties1},
+    {"MAX34451.Polling", properties4},
+    {"MAX34451.Thresholds", properties2},
+    {"MAX5970", properties3},
+    {"MAX5970.BridgeGpio", properties1},
+    {"MAX5970.Polling", properties4},
+    {"MAX5970.Thresholds", properties2},
+    {"MAX6581", properties5},
+    {"MAX6581.Thresholds", properties2},
+    {"MAX6639", properties5},
+    {"MAX6639.Thresholds", properties2},
+    {"MAX6654", properties5},
+    {"MAX6654.Thresholds", properties2},
+    {"MCP9600", properties5},
+    {"MCP9600.Thresholds", properties2},
+    {"MCTPI2CTarget", properties6},
+    {"MCTPI3CTarget", properties9},
+    {"MP2856", properties3},
+    {"MP2856.BridgeGpio", properties1},
+    {"MP2856.Polling", properties4},
+    {"MP2856.Thresholds", properties2},
+    {"MP2857", properties3},
+    {"MP2857.BridgeGpio", properties1},
+    {"MP2857.Polling", properties4},
+    {"MP2857.Thresholds", properties2},
+    {"MP2869", properties3},
+    {"MP2869.BridgeGpio", properties1},
+    {"MP2869.Polling", properties4},
+    {"MP2869.Thresholds", properties2},
+    {"MP2925", properties3},
+    {"MP2925.BridgeGpio", properties1},
+    {"MP2925.Polling", properties4},
+    {"MP2925.Thresholds", properties2},
+    {"MP2929", properties3},
+    {"MP2929.BridgeGpio", properties1},
+    {"MP2929.Polling", properties4},
+    {"MP2929.Thresholds", properties2},
+    {"MP292XFirmware", properties6},
+    {"MP292XFirmware.FirmwareInfo", properties7},
+    {"MP2940XFirmware", properties6},
+    {"MP2940XFirmware.FirmwareInfo", properties7},
+    {"MP29612", properties3},
+    {"MP29612.BridgeGpio", properties1},
+    {"MP29612.Polling", properties4},
+    {"MP29612.Thresholds", properties2},
+    {"MP2971", properties3},
+    {"MP2971.BridgeGpio", properties1},
+    {"MP2971.Polling", properties4},
+    {"MP2971.Thresholds", properties2},
+    {"MP2973", properties3},
+    {"MP2973.BridgeGpio", properties1},
+    {"MP2973.Polling", properties4},
+    {"MP2973.Thresholds", properties2},
+    {"MP2975", properties3},
+    {"MP2975.BridgeGpio", properties1},
+    {"MP2975.Polling", properties4},
+    {"MP2975.Thresholds", properties2},
+    {"MP297XFirmware", properties6},
+    {"MP297XFirmware.FirmwareInfo", properties7},
+    {"MP2993", properties3},
+    {"MP2993.BridgeGpio", properties1},
+    {"MP2993.Polling", properties4},
+    {"MP2993.Thresholds", properties2},
+    {"MP2X6XXFirmware", properties6},
+    {"MP2X6XXFirmware.FirmwareInfo", properties7},
+    {"MP5023", properties3},
+    {"MP5023.BridgeGpio", properties1},
+    {"MP5023.Polling", properties4},
+    {"MP5023.Thresholds", properties2},
+    {"MP5926", properties3},
+    {"MP5926.BridgeGpio", properties1},
+    {"MP5926.Polling", properties4},
+    {"MP5926.Thresholds", properties2},
+    {"MP5990", properties3},
+    {"MP5990.BridgeGpio", properties1},
+    {"MP5990.Polling", properties4},
+    {"MP5990.Thresholds", properties2},
+    {"MP5998", properties3},
+    {"MP5998.BridgeGpio", properties1},
+    {"MP5998.Polling", properties4},
+    {"MP5998.Thresholds", properties2},
+    {"MP5998Firmware", properties6},
+    {"MP5998Firmware.FirmwareInfo", properties7},
+    {"MP9941", properties3},
+    {"MP9941.BridgeGpio", properties1},
+    {"MP9941.Polling", properties4},
+    {"MP9941.Thresholds", properties2},
+    {"MP9945", properties3},
+    {"MP9945.BridgeGpio", properties1},
+    {"MP9945.Polling", properties4},
+    {"MP9945.Thresholds", properties2},
+    {"MP994XFirmware", properties6},
+    {"MP994XFirmware.FirmwareInfo", properties7},
+    {"MPQ8785", properties3},
+    {"MPQ8785.BridgeGpio", properties1},
+    {"MPQ8785.Polling", properties4},
+    {"MPQ8785.Thresholds", properties2},
+    {"MPQ87XXFirmware", properties6},
+    {"MPQ87XXFirmware.FirmwareInfo", properties7},
+    {"Maximum", properties16},
+    {"Maximum.Thresholds", properties2},
+    {"Minimum", properties16},
+    {"Minimum.Thresholds", properties2},
+    {"ModifiedMedian", properties16},
+    {"ModifiedMedian.Thresholds", properties2},
+    {"MultiNodeID", properties9},
+    {"MultiNodePresence", properties6},
+    {"NCP4200", properties3},
+    {"NCP4200.BridgeGpio", properties1},
+    {"NCP4200.Polling", properties4},
+    {"NCP4200.Thresholds", properties2},
+    {"NCT6779", properties5},
+    {"NCT6779.Thresholds", properties2},
+    {"NCT7802", properties5},
+    {"NCT7802.Thresholds", properties2},
+    {"NMSensor", properties9},
+    {"NVME1000", properties32},
+    {"NVME1000.Thresholds", properties2},
+    {"NuvotonFan", properties33},
+    {"NuvotonFan.Connector", properties14},
+    {"NuvotonFan.Thresholds", properties2},
+    {"NvidiaMctpVdm", properties9},
+    {"PCA9537", properties34},
+    {"PCA9542Mux", properties34},
+    {"PCA9543Mux", properties34},
+    {"PCA9544Mux", properties34},
+    {"PCA9545Mux", properties34},
+    {"PCA9546Mux", properties34},
+    {"PCA9547Mux", properties34},
+    {"PCA9548Mux", properties34},
+    {"PCA9846Mux", properties34},
+    {"PCA9847Mux", properties34},
+    {"PCA9848Mux", properties34},
+    {"PCA9849Mux", properties34},
+    {"PLI1209BC", properties3},
+    {"PLI1209BC.BridgeGpio", properties1},
+    {"PLI1209BC.Polling", properties4},
+    {"PLI1209BC.Thresholds", properties2},
+    {"PSUPresence", properties9},
+    {"PT5081LFirmware", properties35},
+    {"PT5081LFirmware.FirmwareInfo", properties7},
+    {"PT5081LFirmware.MuxOutputs", properties8},
+    {"PT5161L", properties5},
+    {"PT5161L.Thresholds", properties2},
+    {"PT5161LFirmware", properties35},
+    {"PT5161LFirmware.FirmwareInfo", properties7},
+    {"PT5161LFirmware.MuxOutputs", properties8},
+    {"PURedundancy", properties9},
+    {"PXE1610", properties3},
+    {"PXE1610.BridgeGpio", properties1},
+    {"PXE1610.Polling", properties4},
+    {"PXE1610.Thresholds", properties2},
+    {"PanasonicBJA3C0002ABatteryBackupUnit", properties11},
+    {"PanasonicBJA3C0002ABatteryBackupUnit.RegisterPollRates", properties12},
+    {"PanasonicBJA3C0002ABatteryBackupUnit.Thresholds", properties2},
+    {"PanasonicBJBPM103APowerMonitorModule", properties11},
+    {"PanasonicBJBPM103APowerMonitorModule.RegisterPollRates", properties12},
+    {"PanasonicBJBPM103APowerMonitorModule.Thresholds", properties2},
+    {"PanasonicBJBSB103APowerShelf", properties11},
+    {"PanasonicBJBSB103APowerShelf.RegisterPollRates", properties12},
+    {"PanasonicBJBSB103APowerShelf.Thresholds", properties2},
+    {"Pid", properties36},
+    {"Pid.Zone", properties37},
+    {"Port", properties38},
+    {"PowerModeProperties", properties39},
+    {"Q54SN120A1", properties3},
+    {"Q54SN120A1.BridgeGpio", properties1},
+    {"Q54SN120A1.Polling", properties4},
+    {"Q54SN120A1.Thresholds", properties2},
+    {"Q54SW120A7", properties3},
+    {"Q54SW120A7.BridgeGpio", properties1},
+    {"Q54SW120A7.Polling", properties4},
+    {"Q54SW120A7.Thresholds", properties2},
+    {"RAA228000", properties3},
+    {"RAA228000.BridgeGpio", properties1},
+    {"RAA228000.Polling", properties4},
+    {"RAA228000.Thresholds", properties2},
+    {"RAA228004", properties3},
+    {"RAA228004.BridgeGpio", properties1},
+    {"RAA228004.Polling", properties4},
+    {"RAA228004.Thresholds", properties2},
+    {"RAA228006", properties3},
+    {"RAA228006.BridgeGpio", properties1},
+    {"RAA228006.Polling", properties4},
+    {"RAA228006.Thresholds", properties2},
+    {"RAA228228", properties3},
+    {"RAA228228.BridgeGpio", properties1},
+    {"RAA228228.Polling", properties4},
+    {"RAA228228.Thresholds", properties2},
+    {"RAA228620", properties3},
+    {"RAA228620.BridgeGpio", properties1},
+    {"RAA228620.Polling", properties4},
+    {"RAA228620.Thresholds", properties2},
+    {"RAA229001", properties3},
+    {"RAA229001.BridgeGpio", properties1},
+    {"RAA229001.Polling", properties4},
+    {"RAA229001.Thresholds", properties2},
+    {"RAA229004", properties3},
+    {"RAA229004.BridgeGpio", properties1},
+    {"RAA229004.Polling", properties4},
+    {"RAA229004.Thresholds", properties2},
+    {"RAA229126", properties3},
+    {"RAA229126.BridgeGpio", properties1},
+    {"RAA229126.Polling", properties4},
+    {"RAA229126.Thresholds", properties2},
+    {"RAA22XGen2Firmware", properties6},
+    {"RAA22XGen2Firmware.FirmwareInfo", properties7},
+    {"RAA22XGen3p5Firmware", properties6},
+    {"RAA22XGen3p5Firmware.FirmwareInfo", properties7},
+    {"RS31390Firmware", properties6},
+    {"RS31390Firmware.FirmwareInfo", properties7},
+    {"RTQ6056", properties3},
+    {"RTQ6056.BridgeGpio", properties1},
+    {"RTQ6056.Polling", properties4},
+    {"RTQ6056.Thresholds", properties2},
+    {"SBRMI", properties3},
+    {"SBRMI.BridgeGpio", properties1},
+    {"SBRMI.Polling", properties4},
+    {"SBRMI.Thresholds", properties2},
+    {"SBTSI", properties5},
+    {"SBTSI.Thresholds", properties2},
+    {"SI7020", properties5},
+    {"SI7020.Thresholds", properties2},
+    {"SQ52206", properties3},
+    {"SQ52206.BridgeGpio", properties1},
+    {"SQ52206.Polling", properties4},
+    {"SQ52206.Thresholds", properties2},
+    {"SY24655", properties3},
+    {"SY24655.BridgeGpio", properties1},
+    {"SY24655.Polling", properties4},
+    {"SY24655.Thresholds", properties2},
+    {"SatelliteController", properties40},
+    {"SpdmTcpResponder", properties41},
+    {"Stepwise", properties42},
+    {"Sum", properties16},
+    {"Sum.Thresholds", properties2},
+    {"TDA38640", properties3},
+    {"TDA38640.BridgeGpio", properties1},
+    {"TDA38640.Polling", properties4},
+    {"TDA38640.Thresholds", properties2},
+    {"TDA38640AFirmware", properties6},
+    {"TDA38640AFirmware.FirmwareInfo", properties7},
+    {"TMP100", properties5},
+    {"TMP100.Thresholds", properties2},
+    {"TMP1075", properties5},
+    {"TMP1075.Thresholds", properties2},
+    {"TMP112", properties5},
+    {"TMP112.Thresholds", properties2},
+    {"TMP175", properties5},
+    {"TMP175.Thresholds", properties2},
+    {"TMP411", properties5},
+    {"TMP411.Thresholds", properties2},
+    {"TMP421", properties5},
+    {"TMP421.Thresholds", properties2},
+    {"TMP432", properties5},
+    {"TMP432.Thresholds", properties2},
+    {"TMP441", properties5},
+    {"TMP441.Thresholds", properties2},
+    {"TMP461", properties5},
+    {"TMP461.Thresholds", properties2},
+    {"TMP464", properties5},
+    {"TMP464.Thresholds", properties2},
+    {"TMP468", properties5},
+    {"TMP468.Thresholds", properties2},
+    {"TMP75", properties5},
+    {"TMP75.Thresholds", properties2},
+    {"TPM2Firmware", properties9},
+    {"TPM2Firmware.FirmwareInfo", properties7},
+    {"TPS25990", properties3},
+    {"TPS25990.BridgeGpio", properties1},
+    {"TPS25990.Polling", properties4},
+    {"TPS25990.Thresholds", properties2},
+    {"TPS25990Firmware", properties6},
+    {"TPS25990Firmware.FirmwareInfo", properties7},
+    {"TPS53679", properties3},
+    {"TPS53679.BridgeGpio", properties1},
+    {"TPS53679.Polling", properties4},
+    {"TPS53679.Thresholds", properties2},
+    {"TPS544X27Firmware", properties6},
+    {"TPS544X27Firmware.FirmwareInfo", properties7},
+    {"TPS546D24", properties3},
+    {"TPS546D24.BridgeGpio", properties1},
+    {"TPS546D24.Polling", properties4},
+    {"TPS546D24.Thresholds", properties2},
+    {"UCD90160", properties6},
+    {"UCD90320", properties6},
+    {"USBPort", properties43},
+    {"W83773G", properties5},
+    {"W83773G.Thresholds", properties2},
+    {"XDP710", properties3},
+    {"XDP710.BridgeGpio", properties1},
+    {"XDP710.Polling", properties4},
+    {"XDP710.Thresholds", properties2},
+    {"XDP71XFirmware", properties6},
+    {"XDP71XFirmware.FirmwareInfo", properties7},
+    {"XDPE11280", properties3},
+    {"XDPE11280.BridgeGpio", properties1},
+    {"XDPE11280.Polling", properties4},
+    {"XDPE11280.Thresholds", properties2},
+    {"XDPE12284", properties3},
+    {"XDPE12284.BridgeGpio", properties1},
+    {"XDPE12284.Polling", properties4},
+    {"XDPE12284.Thresholds", properties2},
+    {"XDPE132G5C", properties3},
+    {"XDPE132G5C.BridgeGpio", properties1},
+    {"XDPE132G5C.Polling", properties4},
+    {"XDPE132G5C.Thresholds", properties2},
+    {"XDPE152C4", properties3},
+    {"XDPE152C4.BridgeGpio", properties1},
+    {"XDPE152C4.Polling", properties4},
+    {"XDPE152C4.Thresholds", properties2},
+    {"XDPE1X2XXFirmware", properties6},
+    {"XDPE1X2XXFirmware.FirmwareInfo", properties7},
+    {"XeonCPU", properties44},
+    {"XeonCPU.Thresholds", properties2},
+    {"cffps", properties3},
+    {"cffps.BridgeGpio", properties1},
+    {"cffps.Polling", properties4},
+    {"cffps.Thresholds", properties2},
+    {"cffps1", properties3},
+    {"cffps1.BridgeGpio", properties1},
+    {"cffps1.Polling", properties4},
+    {"cffps1.Thresholds", properties2},
+    {"cffps2", properties3},
+    {"cffps2.BridgeGpio", properties1},
+    {"cffps2.Polling", properties4},
+    {"cffps2.Thresholds", properties2},
+    {"cffps3", properties3},
+    {"cffps3.BridgeGpio", properties1},
+    {"cffps3.Polling", properties4},
+    {"cffps3.Thresholds", properties2},
+    {"pmbus", properties3},
+    {"pmbus.BridgeGpio", properties1},
+    {"pmbus.Polling", properties4},
+    {"pmbus.Thresholds", properties2},
+    {"smpro_hwmon", properties3},
+    {"smpro_hwmon.BridgeGpio", properties1},
+    {"smpro_hwmon.Polling", properties4},
+    {"smpro_hwmon.Thresholds", properties2},
+}};
+
+} // namespace
+
+std::span<const ExposeProperty> exposePropertyTypes(std::string_view type)
+{
+    auto found = std::ranges::lower_bound(exposeTables, type, std::less<>{},
+                                          &ExposeTable::first);
+    if (found == exposeTables.end() || found->first != type)
+    {
+        return {};
+    }
+    return found->second;
+}
+
+} // namespace dbus_interface
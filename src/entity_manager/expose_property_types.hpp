@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace dbus_interface
+{
+
+enum class PropertyType : uint8_t
+{
+    string,
+    boolean,
+    uint64,
+    int64,
+};
+
+// the D-Bus type of a property of an Exposes record, as the schemas define it
+struct ExposeProperty
+{
+    std::string_view name;
+    PropertyType type;
+    bool array;
+};
+
+// @brief       the properties of a record type the schemas pin the type of,
+//              generated by scripts/generate_expose_property_types.py
+// @param type  the 'Type' of the record, or for the objects nested in it,
+//              the 'Type' and the name of the object, e.g. "TMP75.Thresholds"
+// @returns     the properties sorted by name, empty for unknown types
+std::span<const ExposeProperty> exposePropertyTypes(std::string_view type);
+
+} // namespace dbus_interface
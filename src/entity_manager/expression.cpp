@@ -5,110 +5,226 @@
 
 #include <phosphor-logging/lg2.hpp>
 
-#include <stdexcept>
+#include <charconv>
 
 namespace expression
 {
-std::optional<Operation> parseOperation(std::string& op)
+std::optional<Operation> parseOperation(char op)
 {
-    if (op == "+")
+    switch (op)
     {
-        return Operation::addition;
+        case '+':
+            return Operation::addition;
+        case '-':
+            return Operation::subtraction;
+        case '*':
+            return Operation::multiplication;
+        case '%':
+            return Operation::modulo;
+        case '/':
+            return Operation::division;
+        default:
+            return std::nullopt;
     }
-    if (op == "-")
+}
+
+int64_t evaluate(int64_t a, Operation op, int64_t b)
+{
+    // unsigned arithmetic wraps around instead of overflowing
+    auto ua = static_cast<uint64_t>(a);
+    auto ub = static_cast<uint64_t>(b);
+    switch (op)
     {
-        return Operation::subtraction;
+        case Operation::addition:
+            return static_cast<int64_t>(ua + ub);
+        case Operation::subtraction:
+            return static_cast<int64_t>(ua - ub);
+        case Operation::multiplication:
+            return static_cast<int64_t>(ua * ub);
+        case Operation::division:
+            if (b == 0)
+            {
+                return 0;
+            }
+            // the minimum divided by -1 doesn't fit
+            return b == -1 ? static_cast<int64_t>(0 - ua) : a / b;
+        case Operation::modulo:
+            if (b == 0 || b == -1)
+            {
+                return 0;
+            }
+            return a % b;
     }
-    if (op == "*")
+    return a;
+}
+
+namespace
+{
+
+class Parser
+{
+  public:
+    explicit Parser(std::string_view str) : str(str) {}
+
+    bool at(char c) const
     {
-        return Operation::multiplication;
+        return pos < str.size() && str[pos] == c;
     }
-    if (op == R"(%)")
+
+    void skipSpaces()
     {
-        return Operation::modulo;
+        while (at(' '))
+        {
+            pos++;
+        }
     }
-    if (op == R"(/)")
+
+    // a decimal or hexadecimal number, or a parenthesized group
+    std::optional<int64_t> operand()
     {
-        return Operation::division;
-    }
+        if (at('('))
+        {
+            pos++;
+            return group();
+        }
 
-    return std::nullopt;
-}
+        bool negative = at('-');
+        if (negative)
+        {
+            pos++;
+        }
+        int base = 10;
+        if (str.substr(pos).starts_with("0x"))
+        {
+            pos += 2;
+            base = 16;
+        }
+        if (pos >= str.size() || str[pos] == '-' || str[pos] == '+')
+        {
+            return std::nullopt;
+        }
 
-int evaluate(int a, Operation op, int b)
-{
-    switch (op)
-    {
-        case Operation::addition:
+        int64_t value = 0;
+        const char* begin = str.data() + pos;
+        const char* end = str.data() + str.size();
+        auto [ptr, ec] = std::from_chars(begin, end, value, base);
+        if (ec != std::errc{} || ptr == begin)
         {
-            return a + b;
+            return std::nullopt;
         }
-        case Operation::subtraction:
+        pos += ptr - begin;
+        return negative ? -value : value;
+    }
+
+    std::optional<int64_t> step(int64_t value)
+    {
+        std::optional<Operation> op =
+            pos < str.size() ? parseOperation(str[pos]) : std::nullopt;
+        if (!op)
         {
-            return a - b;
+            return std::nullopt;
         }
-        case Operation::multiplication:
+        pos++;
+        skipSpaces();
+        std::optional<int64_t> rhs = operand();
+        if (!rhs)
         {
-            return a * b;
+            return std::nullopt;
         }
-        case Operation::division:
+        if ((op == Operation::division || op == Operation::modulo) &&
+            *rhs == 0)
         {
-            if (b == 0)
-            {
-                throw std::runtime_error(
-                    "Math error: Attempted to divide by Zero\n");
-            }
-            return a / b;
+            lg2::error("Math error: Attempted to divide by Zero in {STR}",
+                       "STR", str);
+            return std::nullopt;
         }
-        case Operation::modulo:
+        return evaluate(value, *op, *rhs);
+    }
+
+    // the rest of a parenthesized group, evaluated from left to right
+    std::optional<int64_t> group()
+    {
+        skipSpaces();
+        std::optional<int64_t> value = operand();
+        while (value)
         {
-            if (b == 0)
+            skipSpaces();
+            if (at(')'))
             {
-                throw std::runtime_error(
-                    "Math error: Attempted to divide by Zero\n");
+                pos++;
+                return value;
             }
-            return a % b;
+            value = step(*value);
         }
-
-        default:
-            throw std::invalid_argument("Unrecognised operation");
+        return std::nullopt;
     }
-}
 
-int evaluate(int substitute, std::vector<std::string>::iterator curr,
-             std::vector<std::string>::iterator& end)
-{
-    bool isOperator = true;
-    std::optional<Operation> next = Operation::addition;
+    std::string_view str;
+    size_t pos = 0;
+};
+
+} // namespace
 
-    for (; curr != end; curr++)
+std::optional<std::pair<Expression, size_t>> Expression::parse(
+    std::string_view str)
+{
+    Parser parser(str);
+    Expression expression;
+    size_t consumed = 0;
+    while (parser.pos < str.size())
     {
-        if (isOperator)
+        // the words of the expression are separated by a single space
+        if (parser.pos > 0)
         {
-            next = expression::parseOperation(*curr);
-            if (!next)
+            if (!parser.at(' '))
             {
                 break;
             }
+            parser.pos++;
         }
-        else
+
+        std::optional<Operation> op = parseOperation(
+            parser.pos < str.size() ? str[parser.pos] : '\0');
+        if (!op)
         {
-            try
-            {
-                int constant = std::stoi(*curr);
-                substitute = evaluate(substitute, *next, constant);
-            }
-            catch (const std::invalid_argument&)
-            {
-                lg2::error("Parameter not supported for templates {STR}", "STR",
-                           *curr);
-                continue;
-            }
+            break;
+        }
+        parser.pos++;
+        if (!parser.at(' '))
+        {
+            break;
+        }
+        parser.skipSpaces();
+
+        std::optional<int64_t> operand = parser.operand();
+        if (!operand || (parser.pos < str.size() && !parser.at(' ')))
+        {
+            break;
+        }
+        if ((op == Operation::division || op == Operation::modulo) &&
+            *operand == 0)
+        {
+            lg2::error("Math error: Attempted to divide by Zero in {STR}",
+                       "STR", str);
+            break;
         }
-        isOperator = !isOperator;
+        expression.steps.emplace_back(*op, *operand);
+        consumed = parser.pos;
+    }
+
+    if (expression.steps.empty())
+    {
+        return std::nullopt;
     }
+    return std::make_pair(std::move(expression), consumed);
+}
 
-    end = curr;
-    return substitute;
+int64_t Expression::evaluate(int64_t value) const
+{
+    for (const auto& [op, operand] : steps)
+    {
+        value = expression::evaluate(value, op, operand);
+    }
+    return value;
 }
 } // namespace expression
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
-#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace expression
@@ -18,8 +20,32 @@ enum class Operation
     modulo,
 };
 
-std::optional<Operation> parseOperation(const std::string& op);
-int evaluate(int a, Operation op, int b);
-int evaluate(int substitute, std::vector<std::string>::iterator curr,
-             std::vector<std::string>::iterator& end);
+std::optional<Operation> parseOperation(char op);
+
+// Wraps around on overflow. The divisor of a division or modulo must not be
+// zero.
+int64_t evaluate(int64_t a, Operation op, int64_t b);
+
+// The arithmetic following a template, like the "+ 1" of "$bus + 1". The
+// operators are applied from left to right as they always have been, which
+// configurations like "$bus - 1 % 2" rely on. Parentheses group constant
+// subexpressions, e.g. "$bus * (2 + 1)", they are folded when parsing.
+class Expression
+{
+  public:
+    // @brief      parses the expression at the start of 'str', made of an
+    //             operator, a space and an operand, repeated and separated
+    //             by a space
+    // @param str  the text following the template and the character after it
+    // @returns    the expression and the number of characters of 'str' it
+    //             takes, or std::nullopt if 'str' doesn't start with one
+    static std::optional<std::pair<Expression, size_t>> parse(
+        std::string_view str);
+
+    int64_t evaluate(int64_t value) const;
+
+  private:
+    std::vector<std::pair<Operation, int64_t>> steps;
+};
+
 } // namespace expression
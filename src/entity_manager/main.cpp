@@ -6,6 +6,7 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/signal_set.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/asio/connection.hpp>
 
@@ -25,6 +26,19 @@ int main()
 
     em.handleCurrentConfigurationJson();
 
+    // changes of the configuration not written yet aren't lost on shutdown,
+    // and a scan that is running doesn't publish anything anymore
+    boost::asio::signal_set signals(io, SIGINT, SIGTERM);
+    signals.async_wait([&](const boost::system::error_code& ec, int) {
+        if (ec)
+        {
+            return;
+        }
+        em.cancelScan();
+        em.configurationWriter.flush();
+        io.stop();
+    });
+
     io.run();
 
     return 0;
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "object_cache.hpp"
+
+namespace scan
+{
+
+const DBusInterface* ObjectCache::find(
+    std::string_view path, std::string_view interface,
+    std::string_view service) const
+{
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return nullptr;
+    }
+    auto entry = object->second.find(interface);
+    if (entry == object->second.end() || entry->second.service != service)
+    {
+        return nullptr;
+    }
+    return &entry->second.properties;
+}
+
+bool ObjectCache::hasService(std::string_view service) const
+{
+    return services.contains(service);
+}
+
+void ObjectCache::invalidatePath(std::string_view path)
+{
+    invalidatedPaths.emplace(path);
+    isComplete = false;
+    scanComplete = false;
+
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return;
+    }
+    for (const auto& [_, entry] : object->second)
+    {
+        auto service = services.find(entry.service);
+        if (service != services.end())
+        {
+            service->second.erase(std::string(path));
+        }
+    }
+    objects.erase(object);
+}
+
+bool ObjectCache::invalidateService(std::string_view service)
+{
+    scanComplete = false;
+    if (!removeService(service))
+    {
+        return false;
+    }
+    // the service provides its objects again, maybe other ones
+    isComplete = false;
+    return true;
+}
+
+bool ObjectCache::removeService(std::string_view service)
+{
+    invalidatedServices.emplace(service);
+
+    auto found = services.find(service);
+    if (found == services.end())
+    {
+        return false;
+    }
+
+    for (const std::string& path : found->second)
+    {
+        auto object = objects.find(path);
+        if (object == objects.end())
+        {
+            continue;
+        }
+        std::erase_if(object->second, [service](const auto& entry) {
+            return entry.second.service == service;
+        });
+        if (object->second.empty())
+        {
+            objects.erase(object);
+        }
+    }
+    services.erase(found);
+    return true;
+}
+
+void ObjectCache::beginScan()
+{
+    invalidatedPaths.clear();
+    invalidatedServices.clear();
+    scanComplete = true;
+}
+
+void ObjectCache::update(const MapperGetSubTreeResponse& fetchedObjects,
+                         const FetchedInterfaces& fetched)
+{
+    objects.clear();
+    services.clear();
+
+    for (const auto& [path, interfaces] : fetched)
+    {
+        if (invalidatedPaths.contains(path))
+        {
+            continue;
+        }
+        auto properties = fetchedObjects.find(path);
+        if (properties == fetchedObjects.end())
+        {
+            continue;
+        }
+
+        for (const auto& [interface, service] : interfaces)
+        {
+            auto found = properties->second.find(interface);
+            if (found == properties->second.end() ||
+                invalidatedServices.contains(service))
+            {
+                continue;
+            }
+            objects[path].insert_or_assign(interface,
+                                           Entry{service, found->second});
+            services[service].emplace(path);
+        }
+    }
+    isComplete = scanComplete;
+}
+
+void ObjectCache::restore(MapperGetSubTreeResponse& fetchedObjects,
+                          FetchedInterfaces& fetched) const
+{
+    for (const auto& [path, interfaces] : objects)
+    {
+        for (const auto& [interface, entry] : interfaces)
+        {
+            fetchedObjects[path][interface] = entry.properties;
+            fetched[path].insert_or_assign(interface, entry.service);
+        }
+    }
+}
+
+} // namespace scan
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "../utils.hpp"
+
+#include <flat_map>
+#include <flat_set>
+#include <string>
+#include <string_view>
+
+namespace scan
+{
+
+// path -> interface -> bus name of the objects fetched by a scan
+using FetchedInterfaces =
+    std::flat_map<std::string,
+                  std::flat_map<std::string, std::string, std::less<>>,
+                  std::less<>>;
+
+// Properties of the probed objects fetched by earlier scans, along with the
+// service they came from. An entry stays valid until a signal about its
+// object or its service says otherwise, so a scan only has to fetch what
+// changed since the last one.
+class ObjectCache
+{
+  public:
+    // @brief    looks up the cached properties of an object
+    // @returns  the properties, or nullptr if they have to be fetched
+    const DBusInterface* find(std::string_view path, std::string_view interface,
+                              std::string_view service) const;
+
+    // @returns  whether 'service' provided any of the cached objects
+    bool hasService(std::string_view service) const;
+
+    // @brief  drops the cached properties of the object at 'path'
+    void invalidatePath(std::string_view path);
+
+    // @brief    drops the cached properties of every object of 'service'
+    // @returns  whether the service provided any of the cached objects
+    bool invalidateService(std::string_view service);
+
+    // @brief    drops the objects of 'service', which left the bus. Unlike
+    //           an invalidation this leaves the cache complete.
+    // @returns  whether the service provided any of the cached objects
+    bool removeService(std::string_view service);
+
+    // @returns  whether the cache holds every object the last scan fetched
+    //           that is still there, so a scan may use it instead of asking
+    //           the mapper
+    bool complete() const
+    {
+        return isComplete;
+    }
+
+    // @brief  hands out the cached objects like a scan would have fetched
+    //         them
+    void restore(MapperGetSubTreeResponse& fetchedObjects,
+                 FetchedInterfaces& fetched) const;
+
+    // @brief  a scan started, invalidations are from now on also applied to
+    //         what it stores with 'update'
+    void beginScan();
+
+    // @brief  replaces the cache with the objects fetched by a completed scan
+    void update(const MapperGetSubTreeResponse& objects,
+                const FetchedInterfaces& fetched);
+
+  private:
+    struct Entry
+    {
+        std::string service;
+        DBusInterface properties;
+    };
+
+    // path -> interface -> cached properties
+    std::flat_map<std::string, std::flat_map<std::string, Entry, std::less<>>,
+                  std::less<>>
+        objects;
+
+    // service -> paths of the objects it provides
+    std::flat_map<std::string, std::flat_set<std::string, std::less<>>,
+                  std::less<>>
+        services;
+
+    // invalidated since the running scan started, it may have fetched them
+    // before the invalidation
+    std::flat_set<std::string, std::less<>> invalidatedPaths;
+    std::flat_set<std::string, std::less<>> invalidatedServices;
+
+    bool isComplete = false;
+    // whether nothing was invalidated since the running scan started
+    bool scanComplete = true;
+};
+
+} // namespace scan
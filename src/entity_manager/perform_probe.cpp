@@ -15,13 +15,13 @@
 // When an interface passes a probe, also save its D-Bus path with it.
 bool probeDbus(const std::string& interfaceName,
                const std::map<std::string, nlohmann::json>& matches,
-               scan::FoundDevices& devices,
-               const std::shared_ptr<scan::PerformScan>& scan, bool& foundProbe)
+               scan::FoundDevices& devices, const scan::PerformScan& scan,
+               bool& foundProbe)
 {
     bool foundMatch = false;
     foundProbe = false;
 
-    for (const auto& [path, interfaces] : scan->dbusProbeObjects)
+    for (const auto& [path, interfaces] : scan.dbusProbeObjects)
     {
         auto it = interfaces.find(interfaceName);
         if (it == interfaces.end())
@@ -53,7 +53,7 @@ bool probeDbus(const std::string& interfaceName,
         {
             lg2::debug("Found probe match on {PATH} {IFACE}", "PATH", path,
                        "IFACE", interfaceName);
-            devices.emplace_back(interface, path);
+            devices.emplace_back(interface, path, interfaceName);
             foundMatch = true;
         }
     }
@@ -63,8 +63,7 @@ bool probeDbus(const std::string& interfaceName,
 // default probe entry point, iterates a list looking for specific types to
 // call specific probe functions
 bool doProbe(const std::vector<std::string>& probeCommand,
-             const std::shared_ptr<scan::PerformScan>& scan,
-             scan::FoundDevices& foundDevs)
+             const scan::PerformScan& scan, scan::FoundDevices& foundDevs)
 {
     const static std::regex command(R"(\((.*)\))");
     std::smatch match;
@@ -116,9 +115,9 @@ bool doProbe(const std::vector<std::string>& probeCommand,
                     std::string commandStr = *(match.begin() + 1);
                     replaceAll(commandStr, "'", "");
 
-                    cur = (std::find(scan->passedProbes.begin(),
-                                     scan->passedProbes.end(), commandStr) !=
-                           scan->passedProbes.end());
+                    cur = (std::find(scan.passedProbes.begin(),
+                                     scan.passedProbes.end(), commandStr) !=
+                           scan.passedProbes.end());
                     break;
                 }
                 default:
@@ -204,18 +203,17 @@ namespace probe
 
 PerformProbe::PerformProbe(nlohmann::json& recordRef,
                            const std::vector<std::string>& probeCommand,
-                           std::string probeName,
-                           std::shared_ptr<scan::PerformScan>& scanPtr) :
+                           std::string probeName) :
     recordRef(recordRef), _probeCommand(probeCommand),
-    probeName(std::move(probeName)), scan(scanPtr)
+    probeName(std::move(probeName))
 {}
 
-PerformProbe::~PerformProbe()
+void PerformProbe::run(scan::PerformScan& scan) const
 {
     scan::FoundDevices foundDevs;
     if (doProbe(_probeCommand, scan, foundDevs))
     {
-        scan->updateSystemConfiguration(recordRef, probeName, foundDevs);
+        scan.updateSystemConfiguration(recordRef, probeName, foundDevs);
     }
 }
 
@@ -3,27 +3,29 @@
 #include "perform_scan.hpp"
 
 #include <flat_map>
-#include <memory>
 #include <string>
 #include <vector>
 
 namespace probe
 {
 
-// this class finds the needed dbus fields and on destruction runs the probe
+// a configuration to be probed once the D-Bus objects its probe statements
+// refer to have been fetched
 struct PerformProbe final
 {
     PerformProbe(nlohmann::json& recordRef,
                  const std::vector<std::string>& probeCommand,
-                 std::string probeName,
-                 std::shared_ptr<scan::PerformScan>& scanPtr);
-    ~PerformProbe();
+                 std::string probeName);
+
+    // @brief       evaluates the probe against the objects fetched by 'scan'
+    //              and adds the matching devices to the system configuration
+    // @param scan  the scan the probe is part of
+    void run(scan::PerformScan& scan) const;
 
   private:
     nlohmann::json& recordRef;
     std::vector<std::string> _probeCommand;
     std::string probeName;
-    std::shared_ptr<scan::PerformScan> scan;
 };
 
 } // namespace probe
@@ -6,16 +6,20 @@
 #include "object_mapper.hpp"
 #include "perform_probe.hpp"
 #include "probe_type.hpp"
+#include "record_name.hpp"
 #include "utils.hpp"
 
 #include <boost/asio/steady_timer.hpp>
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <charconv>
+#include <chrono>
 #include <flat_map>
 #include <flat_set>
 #include <list>
+#include <string_view>
 
 struct DBusInterfaceInstance
 {
@@ -24,25 +28,53 @@ struct DBusInterfaceInstance
     std::string interface;
 };
 
-static void findDbusObjects(
-    std::vector<std::shared_ptr<probe::PerformProbe>> probeVector,
-    std::flat_set<std::string, std::less<>> interfaces,
+static void querySubtree(
+    const std::string& root, std::flat_set<std::string, std::less<>> interfaces,
     const std::shared_ptr<scan::PerformScan>& scan, boost::asio::io_context& io,
     size_t retries = 5);
 
-static void afterFindDBusObjects(
-    boost::asio::io_context& io,
+static void afterQuerySubtree(
+    boost::asio::io_context& io, const std::string& root,
     std::flat_set<std::string, std::less<>> interfaces,
-    std::vector<std::shared_ptr<probe::PerformProbe>> probeVector,
     const std::shared_ptr<scan::PerformScan>& scan, size_t retries,
     boost::system::error_code ec, const GetSubTreeType& interfaceSubtree);
 
-void getInterfaces(
-    const DBusInterfaceInstance& instance,
-    const std::vector<std::shared_ptr<probe::PerformProbe>>& probeVector,
-    const std::shared_ptr<scan::PerformScan>& scan, boost::asio::io_context& io,
-    size_t retries = 5)
+// Decodes the reply of a GetAll call. While there are records with legacy
+// names, which hash the values of all properties, the properties are decoded
+// in full as well.
+static bool decodeProperties(scan::PerformScan& scan,
+                             const DBusInterfaceInstance& instance,
+                             sdbusplus::message_t& reply,
+                             DBusInterface& properties)
 {
+    const scan::PropertyProjection& projection =
+        scan._em.configuration.probeProperties;
+    if (!scan.legacyRecordNames)
+    {
+        return projection.decode(reply, properties);
+    }
+
+    DBusInterface all;
+    if (!scan::PropertyProjection::decodeAll(reply, all))
+    {
+        // no legacy name was made of it either
+        sd_bus_message_rewind(reply.get(), 1);
+        return projection.decode(reply, properties);
+    }
+    properties = all;
+    projection.project(properties);
+    scan.legacyObjects[instance.path.str][instance.interface] = std::move(all);
+    return true;
+}
+
+static void getInterfaces(const DBusInterfaceInstance& instance,
+                          const std::shared_ptr<scan::PerformScan>& scan,
+                          boost::asio::io_context& io, size_t retries = 5)
+{
+    if (scan->isCancelled())
+    {
+        return;
+    }
     if (retries == 0U)
     {
         lg2::error("retries exhausted on {BUSNAME} {PATH} {INTF}", "BUSNAME",
@@ -51,10 +83,18 @@ void getInterfaces(
         return;
     }
 
+    scan->fetchedInterfaces[instance.path.str].insert_or_assign(
+        instance.interface, instance.busName);
+
+    scan->fetchStarted();
     scan->_em.systemBus->async_method_call(
-        [instance, scan, probeVector, retries,
-         &io](boost::system::error_code& errc,
-              const DBusInterface& resp) mutable {
+        [instance, scan, retries, &io](boost::system::error_code& errc,
+                                       sdbusplus::message_t& reply) mutable {
+            if (scan->isCancelled())
+            {
+                scan->fetchFinished();
+                return;
+            }
             if (errc)
             {
                 // EBADR indicates the D-Bus object was removed between
@@ -68,6 +108,7 @@ void getInterfaces(
                               "{BUSNAME} {PATH} {INTF}",
                               "BUSNAME", instance.busName, "PATH",
                               instance.path, "INTF", instance.interface);
+                    scan->fetchFinished();
                     return;
                 }
 
@@ -75,27 +116,56 @@ void getInterfaces(
                            "BUSNAME", instance.busName, "PATH", instance.path,
                            "INTF", instance.interface);
 
+                // the retry is still part of this fetch
                 auto timer = std::make_shared<boost::asio::steady_timer>(io);
                 timer->expires_after(std::chrono::seconds(2));
 
-                timer->async_wait([timer, instance, scan, probeVector, retries,
+                timer->async_wait([timer, instance, scan, retries,
                                    &io](const boost::system::error_code&) {
-                    getInterfaces(instance, probeVector, scan, io, retries - 1);
+                    getInterfaces(instance, scan, io, retries - 1);
+                    scan->fetchFinished();
                 });
                 return;
             }
 
+            // only the properties configurations refer to are decoded
+            DBusInterface properties;
+            if (!decodeProperties(*scan, instance, reply, properties))
+            {
+                lg2::error("malformed getall reply from {BUSNAME} {PATH} "
+                           "{INTF}",
+                           "BUSNAME", instance.busName, "PATH", instance.path,
+                           "INTF", instance.interface);
+                scan->fetchFinished();
+                return;
+            }
+
             scan->dbusProbeObjects[std::string(instance.path)]
-                                  [std::string(instance.interface)] = resp;
+                                  [std::string(instance.interface)] =
+                std::move(properties);
+            scan->fetchFinished();
         },
         instance.busName, instance.path, "org.freedesktop.DBus.Properties",
         "GetAll", instance.interface);
 }
 
-static void processDbusObjects(
-    std::vector<std::shared_ptr<probe::PerformProbe>>& probeVector,
-    const std::shared_ptr<scan::PerformScan>& scan,
-    const GetSubTreeType& interfaceSubtree, boost::asio::io_context& io)
+// The interfaces of a mapper reply worth fetching the properties of.
+static bool fetchInterface(const std::string& busName,
+                           const std::string& interface)
+{
+    // We should skip ourselve for probing to avoid circular
+    // probes / registrations when a configuration probe uses
+    // an interface that's also being populated by EM itself.
+    // The 3 default org.freedeskstop interfaces (Peer,
+    // Introspectable, and Properties) are returned by
+    // the mapper but don't have properties, so don't bother
+    // with the GetAll call to save some cycles.
+    return busName != emDbusName && !interface.starts_with("org.freedesktop");
+}
+
+static void processDbusObjects(const std::shared_ptr<scan::PerformScan>& scan,
+                               const GetSubTreeType& interfaceSubtree,
+                               boost::asio::io_context& io)
 {
     for (const auto& [path, object] : interfaceSubtree)
     {
@@ -104,35 +174,40 @@ static void processDbusObjects(
 
         for (const auto& [busname, ifaces] : object)
         {
-            // We should skip ourselve for probing to avoid circular
-            // probes / registrations when a configuration probe uses
-            // an interface that's also being populated by EM itself.
-            if (busname != emDbusName)
+            for (const std::string& iface : ifaces)
             {
-                for (const std::string& iface : ifaces)
+                if (!fetchInterface(busname, iface))
+                {
+                    continue;
+                }
+                // while there are legacy names every object is decoded
+                const DBusInterface* cached =
+                    scan->legacyRecordNames
+                        ? nullptr
+                        : scan->_em.objectCache.find(path, iface, busname);
+                if (cached != nullptr)
                 {
-                    // The 3 default org.freedeskstop interfaces (Peer,
-                    // Introspectable, and Properties) are returned by
-                    // the mapper but don't have properties, so don't bother
-                    // with the GetAll call to save some cycles.
-                    if (!iface.starts_with("org.freedesktop"))
-                    {
-                        getInterfaces({busname, path, iface}, probeVector, scan,
-                                      io);
-                    }
+                    scan->fetchedInterfaces[path].insert_or_assign(iface,
+                                                                   busname);
+                    scan->dbusProbeObjects[path][iface] = *cached;
+                    continue;
                 }
+                getInterfaces({busname, path, iface}, scan, io);
             }
         }
     }
 }
 
-static void afterFindDBusObjects(
-    boost::asio::io_context& io,
+static void afterQuerySubtree(
+    boost::asio::io_context& io, const std::string& root,
     std::flat_set<std::string, std::less<>> interfaces,
-    std::vector<std::shared_ptr<probe::PerformProbe>> probeVector,
     const std::shared_ptr<scan::PerformScan>& scan, size_t retries,
     boost::system::error_code ec, const GetSubTreeType& interfaceSubtree)
 {
+    if (scan->isCancelled())
+    {
+        return;
+    }
     if (ec)
     {
         if (ec.value() == ENOENT)
@@ -148,28 +223,51 @@ static void afterFindDBusObjects(
             std::exit(EXIT_FAILURE);
         }
 
+        // the retry is still part of this fetch
+        scan->fetchStarted();
         auto timer = std::make_shared<boost::asio::steady_timer>(io);
         timer->expires_after(std::chrono::seconds(10));
 
-        timer->async_wait([timer, interfaces{std::move(interfaces)}, scan,
-                           probeVector{std::move(probeVector)}, retries,
+        timer->async_wait([timer, root, interfaces{std::move(interfaces)},
+                           scan, retries,
                            &io](const boost::system::error_code&) mutable {
-            findDbusObjects(std::move(probeVector), std::move(interfaces), scan,
-                            io, retries - 1);
+            querySubtree(root, std::move(interfaces), scan, io, retries - 1);
+            scan->fetchFinished();
         });
         return;
     }
 
-    processDbusObjects(probeVector, scan, interfaceSubtree, io);
+    scan->subtreeFetched();
+    processDbusObjects(scan, interfaceSubtree, io);
+}
+
+static void querySubtree(
+    const std::string& root, std::flat_set<std::string, std::less<>> interfaces,
+    const std::shared_ptr<scan::PerformScan>& scan, boost::asio::io_context& io,
+    size_t retries)
+{
+    std::move_only_function<void(boost::system::error_code&,
+                                 const GetSubTreeType& interfaceSubtree)>
+        cb = [root, scan, retries, &io,
+              interfaces](boost::system::error_code& ec,
+                          const GetSubTreeType& interfaceSubtree) mutable {
+            afterQuerySubtree(io, root, interfaces, scan, retries, ec,
+                              interfaceSubtree);
+            scan->fetchFinished();
+        };
+
+    // find all connections in the mapper that expose a specific type
+    scan->fetchStarted();
+    object_mapper::getSubTree(*scan->_em.systemBus, root, 0, interfaces,
+                              std::move(cb));
 }
 
 // Populates scan->dbusProbeObjects with all interfaces and properties
-// for the paths that own the interfaces passed in.
+// for the paths that own the interfaces passed in. The mapper is queried under
+// each of the scan's roots in parallel, or for the whole tree if it has none.
 static void findDbusObjects(
-    std::vector<std::shared_ptr<probe::PerformProbe>> probeVector,
     std::flat_set<std::string, std::less<>> interfaces,
-    const std::shared_ptr<scan::PerformScan>& scan, boost::asio::io_context& io,
-    size_t retries)
+    const std::shared_ptr<scan::PerformScan>& scan, boost::asio::io_context& io)
 {
     // Filter out interfaces already obtained.
     for (const auto& [path, probeInterfaces] : scan->dbusProbeObjects)
@@ -184,52 +282,30 @@ static void findDbusObjects(
         return;
     }
 
-    std::move_only_function<void(boost::system::error_code&,
-                                 const GetSubTreeType& interfaceSubtree)>
-        cb = [probeVector{std::move(probeVector)}, scan, retries, &io,
-              interfaces](boost::system::error_code& ec,
-                          const GetSubTreeType& interfaceSubtree) mutable {
-            afterFindDBusObjects(io, interfaces, probeVector, scan, retries, ec,
-                                 interfaceSubtree);
-        };
-
-    // find all connections in the mapper that expose a specific type
-    object_mapper::getSubTree(*scan->_em.systemBus, "/", 0, interfaces,
-                              std::move(cb));
-}
-
-static std::string getRecordName(const DBusInterface& probe,
-                                 const std::string& probeName)
-{
-    if (probe.empty())
+    if (scan->queryRoots.empty())
     {
-        return probeName;
+        querySubtree("/", std::move(interfaces), scan, io);
+        return;
     }
 
-    // use an array so alphabetical order from the flat_map is maintained
-    auto device = nlohmann::json::array();
-    for (const auto& devPair : probe)
+    for (const std::string& root : scan->queryRoots)
     {
-        device.push_back(devPair.first);
-        std::visit([&device](auto&& v) { device.push_back(v); },
-                   devPair.second);
+        querySubtree(root, interfaces, scan, io);
     }
-
-    // hashes are hard to distinguish, use the non-hashed version if we want
-    // debug
-    // return probeName + device.dump();
-
-    return std::to_string(std::hash<std::string>{}(probeName + device.dump()));
 }
 
 scan::PerformScan::PerformScan(
-    EntityManager& em, nlohmann::json& missingConfigurations,
+    EntityManager& em,
+    std::flat_set<std::string, std::less<>>& missingConfigurations,
     std::vector<nlohmann::json>& configurations, boost::asio::io_context& io,
     std::function<void()>&& callback) :
     _em(em), _missingConfigurations(missingConfigurations),
-    _configurations(configurations), _callback(std::move(callback)), io(io)
+    _configurations(configurations), _callback(std::move(callback)),
+    exposeIndex(em.systemConfiguration), io(io)
 {}
 
+scan::PerformScan::~PerformScan() = default;
+
 static void pruneRecordExposes(nlohmann::json& record)
 {
     auto findExposes = record.find("Exposes");
@@ -318,21 +394,6 @@ static bool extractExposeActionRecordNames(std::vector<std::string>& matches,
     return false;
 }
 
-static std::optional<std::vector<std::string>::iterator> findExposeActionRecord(
-    std::vector<std::string>& matches, const nlohmann::json& record)
-{
-    const auto& name = (record)["Name"].get_ref<const std::string&>();
-    auto compare = [&name](const std::string& s) { return s == name; };
-    auto matchIt = std::find_if(matches.begin(), matches.end(), compare);
-
-    if (matchIt == matches.end())
-    {
-        return std::nullopt;
-    }
-
-    return matchIt;
-}
-
 static void applyBindExposeAction(nlohmann::json::object_t& exposedObject,
                                   nlohmann::json::object_t& expose,
                                   const std::string& propertyName)
@@ -354,35 +415,28 @@ static void applyDisableExposeAction(nlohmann::json::object_t& exposedObject,
     }
 }
 
-static void applyConfigExposeActions(
-    std::vector<std::string>& matches, nlohmann::json::object_t& expose,
-    const std::string& propertyName, nlohmann::json::array_t& configExposes)
+static nlohmann::json* findExposedObject(
+    nlohmann::json& systemConfiguration,
+    const scan::ExposeIndex::Location& location)
 {
-    for (auto& exposedObject : configExposes)
+    auto config = systemConfiguration.find(location.record);
+    if (config == systemConfiguration.end())
     {
-        auto match = findExposeActionRecord(matches, exposedObject);
-        if (match)
-        {
-            matches.erase(*match);
-            nlohmann::json::object_t* exposedObjectObj =
-                exposedObject.get_ptr<nlohmann::json::object_t*>();
-            if (exposedObjectObj == nullptr)
-            {
-                lg2::error("Exposed object wasn't a object: {JSON}", "JSON",
-                           exposedObject.dump());
-                continue;
-            }
-
-            applyBindExposeAction(*exposedObjectObj, expose, propertyName);
-            applyDisableExposeAction(*exposedObjectObj, propertyName);
-        }
+        return nullptr;
+    }
+    auto configList = config->find("Exposes");
+    if (configList == config->end() || !configList->is_array() ||
+        location.expose >= configList->size())
+    {
+        return nullptr;
     }
+    return &(*configList)[location.expose];
 }
 
 static void applyExposeActions(
-    nlohmann::json& systemConfiguration, const std::string& recordName,
-    nlohmann::json::object_t& expose, const std::string& exposeKey,
-    nlohmann::json& exposeValue)
+    nlohmann::json& systemConfiguration, scan::ExposeIndex& exposeIndex,
+    const std::string& recordName, nlohmann::json::object_t& expose,
+    const std::string& exposeKey, nlohmann::json& exposeValue)
 {
     bool isBind = exposeKey.starts_with("Bind");
     bool isDisable = exposeKey == "DisableNode";
@@ -400,30 +454,57 @@ static void applyExposeActions(
         return;
     }
 
-    for (const auto& [configId, config] : systemConfiguration.items())
+    // Each name matches one expose, the first ones in the order of the
+    // system configuration. The action is applied in that order too.
+    std::ranges::sort(matches);
+    std::set<scan::ExposeIndex::Location> targets;
+    bool missing = false;
+    for (auto match = matches.begin(); match != matches.end();)
     {
-        // don't disable ourselves
-        if (isDisable && configId == recordName)
-        {
-            continue;
-        }
+        auto next = std::ranges::find_if(
+            match, matches.end(),
+            [&match](const std::string& name) { return name != *match; });
+        auto count = std::distance(match, next);
 
-        auto configListFind = config.find("Exposes");
-        if (configListFind == config.end())
+        for (const scan::ExposeIndex::Location& location :
+             exposeIndex.find(*match))
         {
-            continue;
+            if (count == 0)
+            {
+                break;
+            }
+            // don't disable ourselves
+            if (isDisable && location.record == recordName)
+            {
+                continue;
+            }
+            targets.insert(location);
+            count--;
         }
+        missing = missing || count > 0;
+        match = next;
+    }
 
-        nlohmann::json::array_t* configList =
-            configListFind->get_ptr<nlohmann::json::array_t*>();
-        if (configList == nullptr)
+    for (const scan::ExposeIndex::Location& location : targets)
+    {
+        nlohmann::json* exposedObject =
+            findExposedObject(systemConfiguration, location);
+        nlohmann::json::object_t* exposedObjectObj =
+            exposedObject == nullptr
+                ? nullptr
+                : exposedObject->get_ptr<nlohmann::json::object_t*>();
+        if (exposedObjectObj == nullptr)
         {
+            lg2::error("Exposed object wasn't a object: {RECORD} {INDEX}",
+                       "RECORD", location.record, "INDEX", location.expose);
             continue;
         }
-        applyConfigExposeActions(matches, expose, exposeKey, *configList);
+
+        applyBindExposeAction(*exposedObjectObj, expose, exposeKey);
+        applyDisableExposeAction(*exposedObjectObj, exposeKey);
     }
 
-    if (!matches.empty())
+    if (missing)
     {
         lg2::error(
             "configuration file dependency error, could not find {KEY} {VALUE}",
@@ -432,21 +513,22 @@ static void applyExposeActions(
 }
 
 static std::string generateDeviceName(
-    const std::set<nlohmann::json>& usedNames, const DBusObject& dbusObject,
-    size_t foundDeviceIdx, const std::string& nameTemplate,
+    const std::set<nlohmann::json>& usedNames,
+    const em_utils::TemplateProperties& properties,
+    const em_utils::TemplatePlans& plans, const std::string& nameTemplate,
     std::optional<std::string>& replaceStr)
 {
     nlohmann::json copyForName = nameTemplate;
     std::optional<std::string> replaceVal = em_utils::templateCharReplace(
-        copyForName, dbusObject, foundDeviceIdx, replaceStr);
+        copyForName, properties, plans, replaceStr);
 
     if (!replaceStr && replaceVal)
     {
         if (usedNames.contains(nameTemplate))
         {
             replaceStr = replaceVal;
-            em_utils::templateCharReplace(copyForName, dbusObject,
-                                          foundDeviceIdx, replaceStr);
+            em_utils::templateCharReplace(copyForName, properties, plans,
+                                          replaceStr);
         }
     }
 
@@ -465,10 +547,10 @@ static std::string generateDeviceName(
     }
     return *ret;
 }
-static void applyTemplateAndExposeActions(
-    const std::string& recordName, const DBusObject& dbusObject,
-    size_t foundDeviceIdx, const std::optional<std::string>& replaceStr,
-    nlohmann::json& value, nlohmann::json& systemConfiguration)
+static void applyExposeObjectActions(const std::string& recordName,
+                                     nlohmann::json& value,
+                                     nlohmann::json& systemConfiguration,
+                                     scan::ExposeIndex& exposeIndex)
 {
     nlohmann::json::object_t* exposeObj =
         value.get_ptr<nlohmann::json::object_t*>();
@@ -478,29 +560,37 @@ static void applyTemplateAndExposeActions(
     }
     for (auto& [key, value] : *exposeObj)
     {
-        em_utils::templateCharReplace(value, dbusObject, foundDeviceIdx,
-                                      replaceStr);
-
-        applyExposeActions(systemConfiguration, recordName, *exposeObj, key,
-                           value);
+        applyExposeActions(systemConfiguration, exposeIndex, recordName,
+                           *exposeObj, key, value);
     }
 };
 
 void scan::PerformScan::restorePersistedConfigurations(
     FoundDevices& foundDevices, const std::string& probeName,
-    std::set<nlohmann::json>& usedNames, std::list<size_t>& indexes)
+    const PropertyProjection& templates, std::set<nlohmann::json>& usedNames,
+    std::list<size_t>& indexes)
 {
     // Copy over persisted configurations and make sure we remove indexes
     // that are already used.
     for (auto itr = foundDevices.begin(); itr != foundDevices.end();)
     {
-        std::string recordName = getRecordName(itr->interface, probeName);
+        std::string recordName = scan::recordName(itr->interface, probeName);
+        if (_em.recordInputs.stale(recordName))
+        {
+            // a property it was templated from changed, instantiate it again
+            itr++;
+            continue;
+        }
 
         auto record = _em.systemConfiguration.find(recordName);
         if (record == _em.systemConfiguration.end())
         {
             record = _em.lastJson.find(recordName);
             if (record == _em.lastJson.end())
+            {
+                record = migrateLegacyRecord(*itr, probeName, recordName);
+            }
+            if (record == _em.lastJson.end())
             {
                 itr++;
                 continue;
@@ -509,8 +599,10 @@ void scan::PerformScan::restorePersistedConfigurations(
             pruneRecordExposes(*record);
 
             _em.systemConfiguration[recordName] = *record;
+            exposeIndex.recordChanged(recordName);
         }
         _missingConfigurations.erase(recordName);
+        trackRecordInputs(recordName, itr->path, templates);
 
         // We've processed the device, remove it and advance the iterator.
         itr = foundDevices.erase(itr);
@@ -518,21 +610,57 @@ void scan::PerformScan::restorePersistedConfigurations(
     }
 }
 
+nlohmann::json::iterator scan::PerformScan::migrateLegacyRecord(
+    const DBusDeviceDescriptor& device, const std::string& probeName,
+    const std::string& recordName)
+{
+    // the legacy name hashes the values of all properties, not the digests
+    // of the projection
+    const DBusInterface* probe = nullptr;
+    auto object = legacyObjects.find(device.path);
+    if (object != legacyObjects.end())
+    {
+        auto interface = object->second.find(device.interfaceName);
+        if (interface != object->second.end())
+        {
+            probe = &interface->second;
+        }
+    }
+    if (probe == nullptr)
+    {
+        return _em.lastJson.end();
+    }
+
+    std::string legacyName = legacyRecordName(*probe, probeName);
+    auto legacy = _em.lastJson.find(legacyName);
+    if (legacy == _em.lastJson.end())
+    {
+        return legacy;
+    }
+
+    lg2::info("Migrating persisted record {LEGACY} to {NAME}", "LEGACY",
+              legacyName, "NAME", recordName);
+    // lastJson is keyed by the new name too, so the device isn't reported
+    // as removed
+    nlohmann::json record = std::move(*legacy);
+    _em.lastJson.erase(legacy);
+    return _em.lastJson.emplace(recordName, std::move(record)).first;
+}
+
 static void replaceTemplateFields(
-    nlohmann::json::object_t& record, const DBusObject& dbusObject,
-    size_t foundDeviceIdx, std::optional<std::string>& replaceStr)
+    nlohmann::json::object_t& record,
+    const em_utils::TemplateProperties& properties,
+    const em_utils::TemplatePlans& plans,
+    std::optional<std::string>& replaceStr)
 {
     for (auto& keyPair : record)
     {
         if (keyPair.first != "Name")
         {
             // "Probe" string does not contain template variables
-            // Handle left-over variables for "Exposes" later below
-            const bool handleLeftOver =
-                (keyPair.first != "Probe") && (keyPair.first != "Exposes");
-            em_utils::templateCharReplace(keyPair.second, dbusObject,
-                                          foundDeviceIdx, replaceStr,
-                                          handleLeftOver);
+            const bool handleLeftOver = keyPair.first != "Probe";
+            em_utils::templateCharReplace(keyPair.second, properties, plans,
+                                          replaceStr, handleLeftOver);
         }
     }
 }
@@ -556,23 +684,22 @@ static const std::string* configuredName(const nlohmann::json::object_t& record,
 }
 
 static void applyExposes(const std::string& recordName, nlohmann::json& expose,
-                         const DBusObject& dbusObject, size_t foundDeviceIdx,
-                         std::optional<std::string>& replaceStr,
-                         nlohmann::json& systemConfiguration)
+                         nlohmann::json& systemConfiguration,
+                         scan::ExposeIndex& exposeIndex)
 {
     nlohmann::json::array_t* exposeArr =
         expose.get_ptr<nlohmann::json::array_t*>();
     if (exposeArr == nullptr)
     {
-        applyTemplateAndExposeActions(recordName, dbusObject, foundDeviceIdx,
-                                      replaceStr, expose, systemConfiguration);
+        applyExposeObjectActions(recordName, expose, systemConfiguration,
+                                 exposeIndex);
         return;
     }
 
     for (auto& value : *exposeArr)
     {
-        applyTemplateAndExposeActions(recordName, dbusObject, foundDeviceIdx,
-                                      replaceStr, value, systemConfiguration);
+        applyExposeObjectActions(recordName, value, systemConfiguration,
+                                 exposeIndex);
     }
 }
 
@@ -595,8 +722,9 @@ static void addRecordProbePath(const nlohmann::json::object_t& record,
 
 void scan::PerformScan::updateSystemConfigurationForDevice(
     const nlohmann::json& recordRef, const std::string& probeName,
-    const DBusDeviceDescriptor& device, std::set<nlohmann::json>& usedNames,
-    std::list<size_t>& indexes, std::optional<std::string>& replaceStr)
+    const PropertyProjection& templates, const DBusDeviceDescriptor& device,
+    std::set<nlohmann::json>& usedNames, std::list<size_t>& indexes,
+    std::optional<std::string>& replaceStr)
 {
     // Need all interfaces on this path so that template
     // substitutions can be done with any of the contained
@@ -619,10 +747,13 @@ void scan::PerformScan::updateSystemConfigurationForDevice(
         return;
     }
     nlohmann::json::object_t record = *recordPtr;
-    std::string recordName = getRecordName(device.interface, probeName);
+    std::string recordName = scan::recordName(device.interface, probeName);
     size_t foundDeviceIdx = indexes.front();
     indexes.pop_front();
 
+    const em_utils::TemplateProperties properties(dbusObject, foundDeviceIdx);
+    const em_utils::TemplatePlans& plans = _em.configuration.templatePlans;
+
     // check name first so we have no duplicate names
     const std::string* name = configuredName(record, recordRef);
     if (name == nullptr)
@@ -630,33 +761,42 @@ void scan::PerformScan::updateSystemConfigurationForDevice(
         return;
     }
 
-    std::string deviceName = generateDeviceName(
-        usedNames, dbusObject, foundDeviceIdx, *name, replaceStr);
+    std::string deviceName =
+        generateDeviceName(usedNames, properties, plans, *name, replaceStr);
 
     record["Name"] = deviceName;
 
     usedNames.insert(deviceName);
 
-    replaceTemplateFields(record, dbusObject, foundDeviceIdx, replaceStr);
-
-    // insert into configuration temporarily to be able to
-    // reference ourselves
+    replaceTemplateFields(record, properties, plans, replaceStr);
 
-    _em.systemConfiguration[recordName] = record;
+    // The instance is complete but for the expose actions, which may refer
+    // to its own exposes. It is moved into the configuration and the actions
+    // are applied to it there.
+    nlohmann::json& instance = _em.systemConfiguration[recordName];
+    auto publishedName = instance.find("Name");
+    if (publishedName != instance.end() && publishedName->is_string())
+    {
+        // instantiated again, e.g. because it was stale
+        _em.replacedRecords.try_emplace(recordName,
+                                        publishedName->get<std::string>());
+    }
+    instance = std::move(record);
+    exposeIndex.recordChanged(recordName);
+    trackRecordInputs(recordName, device.path, templates);
 
-    auto findExpose = record.find("Exposes");
-    if (findExpose == record.end())
+    auto findExpose = instance.find("Exposes");
+    if (findExpose == instance.end())
     {
         return;
     }
 
-    applyExposes(recordName, findExpose->second, dbusObject, foundDeviceIdx,
-                 replaceStr, _em.systemConfiguration);
+    applyExposes(recordName, *findExpose, _em.systemConfiguration,
+                 exposeIndex);
 
-    addRecordProbePath(record, device.path, _em.topology);
+    addRecordProbePath(instance.get_ref<const nlohmann::json::object_t&>(),
+                       device.path, _em.topology);
 
-    // overwrite ourselves with cleaned up version
-    _em.systemConfiguration[recordName] = record;
     _missingConfigurations.erase(recordName);
 }
 
@@ -671,15 +811,42 @@ void scan::PerformScan::updateSystemConfiguration(
     std::list<size_t> indexes(foundDevices.size());
     std::iota(indexes.begin(), indexes.end(), 1);
 
-    restorePersistedConfigurations(foundDevices, probeName, usedNames, indexes);
+    PropertyProjection templates;
+    templates.addTemplates(recordRef);
+
+    restorePersistedConfigurations(foundDevices, probeName, templates,
+                                   usedNames, indexes);
 
     std::optional<std::string> replaceStr;
 
     for (const DBusDeviceDescriptor& device : foundDevices)
     {
-        updateSystemConfigurationForDevice(recordRef, probeName, device,
-                                           usedNames, indexes, replaceStr);
+        updateSystemConfigurationForDevice(recordRef, probeName, templates,
+                                           device, usedNames, indexes,
+                                           replaceStr);
+    }
+}
+
+void scan::PerformScan::trackRecordInputs(const std::string& recordName,
+                                          const std::string& path,
+                                          const PropertyProjection& templates)
+{
+    std::flat_set<RecordInputs::Input> inputs;
+    auto object = dbusProbeObjects.find(path);
+    if (object != dbusProbeObjects.end())
+    {
+        for (const auto& [interface, properties] : object->second)
+        {
+            for (const auto& [property, _] : properties)
+            {
+                if (templates.referenced(property))
+                {
+                    inputs.emplace(path, interface, property);
+                }
+            }
+        }
     }
+    _em.recordInputs.set(recordName, std::move(inputs));
 }
 
 std::vector<std::string> scan::detail::parseProbeCommand(
@@ -714,15 +881,62 @@ std::vector<std::string> scan::detail::parseProbeCommand(
     return probeCommand;
 }
 
+// Paths are mapped to the root made of their first few segments, e.g.
+// /xyz/openbmc_project/FruDevice for /xyz/openbmc_project/FruDevice/1_50.
+static constexpr size_t probeRootDepth = 3;
+
+std::flat_set<std::string, std::less<>> scan::detail::deriveProbeRoots(
+    const MapperGetSubTreeResponse& objects)
+{
+    std::flat_set<std::string, std::less<>> candidates;
+    for (const auto& [path, _] : objects)
+    {
+        // a root strictly contains its objects, the mapper doesn't report the
+        // object a subtree query is made on
+        auto segments = static_cast<size_t>(std::ranges::count(path, '/'));
+        size_t depth =
+            segments > 1 ? std::min(probeRootDepth, segments - 1) : 0;
+        size_t end = 0;
+        for (size_t i = 0; i < depth; i++)
+        {
+            end = path.find('/', end + 1);
+        }
+        candidates.emplace(depth == 0 ? "/" : path.substr(0, end));
+    }
+
+    // drop roots nested in others, sorting puts a root before its children
+    std::flat_set<std::string, std::less<>> roots;
+    for (const std::string& root : candidates)
+    {
+        if (roots.empty() || !pathUnderRoots(roots, root))
+        {
+            roots.emplace(root);
+        }
+    }
+    return roots;
+}
+
+bool scan::detail::pathUnderRoots(
+    const std::flat_set<std::string, std::less<>>& roots, std::string_view path)
+{
+    return std::ranges::any_of(roots, [path](std::string_view root) {
+        if (root == "/" || path == root)
+        {
+            return true;
+        }
+        return path.starts_with(root) && path.size() > root.size() &&
+               path[root.size()] == '/';
+    });
+}
+
 // From a config's parsed probe statements, collect the D-Bus interface names
-// that need to be probed (discarding non-D-Bus probe types) and record that
-// this config's PerformProbe cares about each of them.
-static void collectDbusProbes(
+// that need to be probed (discarding non-D-Bus probe types). Returns whether
+// the config probes any D-Bus interface.
+static bool collectDbusProbes(
     const std::vector<std::string>& probeCommand,
-    const std::shared_ptr<probe::PerformProbe>& probePointer,
-    std::flat_set<std::string, std::less<>>& dbusProbeInterfaces,
-    std::vector<std::shared_ptr<probe::PerformProbe>>& dbusProbePointers)
+    std::flat_set<std::string, std::less<>>& dbusProbeInterfaces)
 {
+    bool dbusProbe = false;
     for (const std::string& probe : probeCommand)
     {
         if (probe::findProbeType(probe))
@@ -733,8 +947,9 @@ static void collectDbusProbes(
         auto findStart = probe.find('(');
         std::string interface = probe.substr(0, findStart);
         dbusProbeInterfaces.emplace(interface);
-        dbusProbePointers.emplace_back(probePointer);
+        dbusProbe = true;
     }
+    return dbusProbe;
 }
 
 static const std::string* pendingProbeName(
@@ -763,9 +978,7 @@ static const std::string* pendingProbeName(
     return probeName;
 }
 
-bool scan::PerformScan::processConfigurations(
-    std::flat_set<std::string, std::less<>>& dbusProbeInterfaces,
-    std::vector<std::shared_ptr<probe::PerformProbe>>& dbusProbePointers)
+bool scan::PerformScan::processConfigurations()
 {
     for (auto it = _configurations.begin(); it != _configurations.end();)
     {
@@ -794,16 +1007,18 @@ bool scan::PerformScan::processConfigurations(
             return false;
         }
 
-        // store reference to this to children to makes sure we don't get
-        // destroyed too early
-        auto thisRef = shared_from_this();
-        auto probePointer = std::make_shared<probe::PerformProbe>(
-            recordRef, probeCommand, *probeName, thisRef);
+        probe::PerformProbe probe(recordRef, probeCommand, *probeName);
 
-        // parse out dbus probes by discarding other probe types, store in a
-        // map
-        collectDbusProbes(probeCommand, probePointer, dbusProbeInterfaces,
-                          dbusProbePointers);
+        // parse out dbus probes by discarding other probe types, those
+        // without any can be evaluated right away
+        if (collectDbusProbes(probeCommand, probeInterfaces))
+        {
+            probes.emplace_back(std::move(probe));
+        }
+        else
+        {
+            probe.run(*this);
+        }
         it++;
     }
 
@@ -812,33 +1027,274 @@ bool scan::PerformScan::processConfigurations(
 
 void scan::PerformScan::run()
 {
-    std::flat_set<std::string, std::less<>> dbusProbeInterfaces;
-    std::vector<std::shared_ptr<probe::PerformProbe>> dbusProbePointers;
+    if (cancelled)
+    {
+        return;
+    }
+
+    pass++;
+    _passed = false;
+    probes.clear();
+    probeInterfaces.clear();
+    enterPhase(Phase::collect);
+
+    if (pass == 1)
+    {
+        legacyRecordNames =
+            std::ranges::any_of(_em.lastJson.items(), [](const auto& item) {
+                return isLegacyRecordName(item.key());
+            });
+        if (legacyRecordNames)
+        {
+            // records persisted under a legacy name are only found with the
+            // values of all properties, which only fetching them provides
+            speculative = false;
+            cached = false;
+        }
+        if (!cached)
+        {
+            queryRoots = _em.takeScanQueryRoots();
+        }
+        _em.objectCache.beginScan();
+    }
 
-    if (!processConfigurations(dbusProbeInterfaces, dbusProbePointers))
+    if (!processConfigurations())
     {
+        // evaluate what was collected so far without fetching anything
+        evaluate();
         return;
     }
 
-    // probe vector stores a shared_ptr to each PerformProbe that cares
-    // about a dbus interface
-    findDbusObjects(std::move(dbusProbePointers),
-                    std::move(dbusProbeInterfaces), shared_from_this(), io);
+    if (speculative)
+    {
+        // evaluate against the objects of the previous boot, the following
+        // scan validates the result against D-Bus
+        if (pass == 1)
+        {
+            dbusProbeObjects = snapshot->objects;
+        }
+        evaluate();
+        return;
+    }
+    if (cached)
+    {
+        // the objects of the last scan, but those of the services that left
+        if (pass == 1)
+        {
+            _em.objectCache.restore(dbusProbeObjects, fetchedInterfaces);
+        }
+        evaluate();
+        return;
+    }
+
+    enterPhase(Phase::subtree);
+
+    // hold the fetch open until every request was issued
+    fetchStarted();
+    findDbusObjects(probeInterfaces, shared_from_this(), io);
+    fetchFinished();
 }
 
-scan::PerformScan::~PerformScan()
+void scan::PerformScan::cancel()
 {
-    if (_passed)
+    lg2::debug("scan cancelled in pass {PASS}", "PASS", pass);
+    cancelled = true;
+    probes.clear();
+}
+
+bool scan::PerformScan::usesService(std::string_view service) const
+{
+    for (const auto& [path, interfaces] : fetchedInterfaces)
+    {
+        for (const auto& [interface, busName] : interfaces)
+        {
+            if (busName == service)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void scan::PerformScan::fetchStarted()
+{
+    pendingFetches++;
+}
+
+void scan::PerformScan::fetchFinished()
+{
+    pendingFetches--;
+    if (pendingFetches == 0 && !cancelled)
+    {
+        fetchComplete();
+    }
+}
+
+void scan::PerformScan::subtreeFetched()
+{
+    if (phase == Phase::subtree)
     {
-        auto nextScan = std::make_shared<PerformScan>(
-            _em, _missingConfigurations, _configurations, io,
-            std::move(_callback));
-        nextScan->passedProbes = std::move(passedProbes);
-        nextScan->dbusProbeObjects = std::move(dbusProbeObjects);
-        boost::asio::post(_em.io, [nextScan]() { nextScan->run(); });
+        enterPhase(Phase::properties);
+    }
+}
+
+// Up to this many changed objects are fetched again individually, more than
+// that and the whole fetch is restarted.
+static constexpr size_t maxRefetchedObjects = 16;
+// Bounds how often a scan merges changes, so that constant churn cannot keep
+// it from ever completing.
+static constexpr size_t maxMergedChanges = 3;
+
+bool scan::PerformScan::mergeChanges()
+{
+    // Changes can only be merged before any D-Bus probe ran, later passes
+    // work on top of records already derived from the fetched data. Anything
+    // left over is handled by a follow-up scan.
+    if (pass > 1 || mergedChanges >= maxMergedChanges)
+    {
+        return false;
+    }
+
+    ScanChanges changes = _em.takeScanChanges();
+    if (changes.empty())
+    {
+        return false;
+    }
+    mergedChanges++;
+
+    fetchStarted();
+    if (changes.structural || changes.paths.size() > maxRefetchedObjects)
+    {
+        lg2::debug("restarting scan fetch after changes");
+        dbusProbeObjects.clear();
+        fetchedInterfaces.clear();
+        queryRoots = _em.takeScanQueryRoots();
+        enterPhase(Phase::subtree);
+        findDbusObjects(probeInterfaces, shared_from_this(), io);
     }
     else
     {
-        _callback();
+        for (const std::string& path : changes.paths)
+        {
+            auto fetched = fetchedInterfaces.find(path);
+            if (fetched == fetchedInterfaces.end())
+            {
+                continue; // not part of this scan
+            }
+
+            lg2::debug("fetching {PATH} again after it changed", "PATH", path);
+            for (const auto& [interface, busName] : fetched->second)
+            {
+                getInterfaces({busName, path, interface}, shared_from_this(),
+                              io);
+            }
+        }
+    }
+
+    // evaluate right away if nothing needed fetching after all
+    pendingFetches--;
+    return pendingFetches != 0;
+}
+
+void scan::PerformScan::fetchComplete()
+{
+    if (mergeChanges())
+    {
+        return;
+    }
+    evaluate();
+}
+
+void scan::PerformScan::evaluate()
+{
+    enterPhase(Phase::evaluate);
+    for (const probe::PerformProbe& probe : probes)
+    {
+        probe.run(*this);
+    }
+    probes.clear();
+    enterPhase(Phase::done);
+
+    lg2::debug("scan pass {PASS} took {COLLECT}us collecting, {SUBTREE}us "
+               "querying the mapper, {PROPERTIES}us fetching properties and "
+               "{EVALUATE}us evaluating probes",
+               "PASS", pass, "COLLECT", phaseMicros(Phase::collect), "SUBTREE",
+               phaseMicros(Phase::subtree), "PROPERTIES",
+               phaseMicros(Phase::properties), "EVALUATE",
+               phaseMicros(Phase::evaluate));
+
+    if (_passed)
+    {
+        // a probe passed, run another pass for configurations depending on
+        // it
+        boost::asio::post(_em.io, [scan = shared_from_this()]() {
+            scan->run();
+        });
+        return;
+    }
+
+    lg2::debug("scan completed in {PASSES} passes, {MILLIS}ms", "PASSES", pass,
+               "MILLIS",
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - scanStart)
+                   .count());
+    if (!cached)
+    {
+        _em.learnProbeRoots(dbusProbeObjects, queryRoots.empty());
     }
+    if (!speculative)
+    {
+        _em.objectCache.update(dbusProbeObjects, fetchedInterfaces);
+        saveSnapshot();
+    }
+    _callback();
+}
+
+void scan::PerformScan::useSnapshot(
+    std::shared_ptr<const ProbeSnapshot> objects)
+{
+    snapshot = std::move(objects);
+    speculative = true;
+}
+
+void scan::PerformScan::useObjectCache()
+{
+    cached = true;
+}
+
+void scan::PerformScan::saveSnapshot() const
+{
+    ProbeSnapshot current;
+    current.objects = dbusProbeObjects;
+    _em.saveProbeSnapshot(current);
+}
+
+void scan::PerformScan::enterPhase(Phase next)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (next == Phase::collect)
+    {
+        phaseTimes.fill({});
+    }
+    else if (phase != Phase::done)
+    {
+        phaseTimes[static_cast<size_t>(phase)] += now - phaseStart;
+    }
+    phase = next;
+    phaseStart = now;
+
+    // probes are evaluated in these phases, D-Bus clients may have modified
+    // the system configuration while the scan was waiting
+    if (next == Phase::collect || next == Phase::evaluate)
+    {
+        exposeIndex.invalidate();
+    }
+}
+
+int64_t scan::PerformScan::phaseMicros(Phase p) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               phaseTimes[static_cast<size_t>(p)])
+        .count();
 }
@@ -2,12 +2,19 @@
 
 #include "../utils.hpp"
 #include "entity_manager.hpp"
+#include "expose_index.hpp"
+#include "object_cache.hpp"
+#include "probe_snapshot.hpp"
+#include "property_projection.hpp"
 
 #include <systemd/sd-journal.h>
 
 #include <nlohmann/json.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <flat_map>
 #include <flat_set>
 #include <functional>
@@ -15,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <string_view>
 #include <vector>
 
 namespace probe
@@ -28,48 +36,168 @@ struct DBusDeviceDescriptor
 {
     DBusInterface interface;
     std::string path;
+    // name of 'interface', empty for a device not found on D-Bus
+    std::string interfaceName;
 };
 
 using FoundDevices = std::vector<DBusDeviceDescriptor>;
 
+// Runs the configured probes against D-Bus, in passes until no further probe
+// passes. Each pass goes through explicit phases: the probes are collected
+// from the configurations, the mapper is queried for the probed interfaces,
+// the properties of the matching objects are fetched and finally the probes
+// are evaluated. The callback is invoked once the last pass completed.
 struct PerformScan final : std::enable_shared_from_this<PerformScan>
 {
-    PerformScan(EntityManager& em, nlohmann::json& missingConfigurations,
+    // @param missingConfigurations  names of the records of the system
+    //                               configuration, the scan removes those
+    //                               of the devices it finds
+    PerformScan(EntityManager& em,
+                std::flat_set<std::string, std::less<>>& missingConfigurations,
                 std::vector<nlohmann::json>& configurations,
                 boost::asio::io_context& io, std::function<void()>&& callback);
 
     void updateSystemConfiguration(const nlohmann::json& recordRef,
                                    const std::string& probeName,
                                    FoundDevices& foundDevices);
+
+    // @brief  starts the next pass of the scan
     void run();
+
+    // @brief  stops the scan, outstanding requests are ignored when they
+    //         complete and the callback is not invoked
+    void cancel();
+
+    bool isCancelled() const
+    {
+        return cancelled;
+    }
+
+    // @returns  whether the scan fetched properties of objects of 'service'
+    bool usesService(std::string_view service) const;
+
+    // @brief  a D-Bus request was issued on behalf of the current pass
+    void fetchStarted();
+
+    // @brief  a D-Bus request of the current pass completed, once the last
+    //         one did the probes are evaluated
+    void fetchFinished();
+
+    // @brief  the mapper answered, the object properties are fetched next
+    void subtreeFetched();
+
+    // @brief          evaluates the probes against the objects probed on a
+    //                 previous boot instead of fetching them, a scan
+    //                 following right after validates the result
+    // @param objects  the snapshot of these objects
+    void useSnapshot(std::shared_ptr<const ProbeSnapshot> objects);
+
+    // @brief  evaluates the probes against the cached objects instead of
+    //         asking the mapper, when only services left the bus since the
+    //         last scan
+    void useObjectCache();
+
     ~PerformScan();
     EntityManager& _em;
     MapperGetSubTreeResponse dbusProbeObjects;
     std::vector<std::string> passedProbes;
 
+    // objects probed on a previous boot, see 'useSnapshot'
+    std::shared_ptr<const ProbeSnapshot> snapshot;
+
+    // object path roots the mapper is queried under, empty to query the
+    // whole tree
+    std::vector<std::string> queryRoots;
+
+    // path -> interface -> bus name of everything fetched by this scan
+    FetchedInterfaces fetchedInterfaces;
+
+    // whether lastJson has records with legacy names, checked when the scan
+    // starts
+    bool legacyRecordNames = false;
+
+    // the objects fetched while there are legacy names, with every property
+    // decoded in full rather than projected, which legacy names hash
+    MapperGetSubTreeResponse legacyObjects;
+
   private:
+    enum class Phase
+    {
+        collect,
+        subtree,
+        properties,
+        evaluate,
+        done,
+    };
+
     void restorePersistedConfigurations(
         FoundDevices& foundDevices, const std::string& probeName,
+        const PropertyProjection& templates,
         std::set<nlohmann::json>& usedNames, std::list<size_t>& indexes);
 
+    // @brief  finds the persisted record of a device named the way records
+    //         were before recordName(), and re-keys it under 'recordName'
+    // @returns  the record in lastJson, or lastJson.end() if there is none
+    nlohmann::json::iterator migrateLegacyRecord(
+        const DBusDeviceDescriptor& device, const std::string& probeName,
+        const std::string& recordName);
+
     void updateSystemConfigurationForDevice(
         const nlohmann::json& recordRef, const std::string& probeName,
-        const DBusDeviceDescriptor& device, std::set<nlohmann::json>& usedNames,
-        std::list<size_t>& indexes, std::optional<std::string>& replaceStr);
+        const PropertyProjection& templates, const DBusDeviceDescriptor& device,
+        std::set<nlohmann::json>& usedNames, std::list<size_t>& indexes,
+        std::optional<std::string>& replaceStr);
+
+    // @brief            remembers the properties of the device at 'path' the
+    //                   templates of a record may be replaced with
+    // @param templates  the templates of the record's configuration
+    void trackRecordInputs(const std::string& recordName,
+                           const std::string& path,
+                           const PropertyProjection& templates);
 
     // Walk _configurations, dropping malformed or already-probed entries and
-    // starting a PerformProbe for each remaining one. Collects the D-Bus
-    // interfaces to look up into dbusProbeInterfaces / dbusProbePointers.
+    // creating a PerformProbe for each remaining one. Probes without D-Bus
+    // statements are evaluated right away, the others are kept in 'probes'
+    // with their interfaces collected into 'probeInterfaces'.
     // Returns false if a config had an unparsable Probe, in which case the
     // scan must not continue.
-    bool processConfigurations(
-        std::flat_set<std::string, std::less<>>& dbusProbeInterfaces,
-        std::vector<std::shared_ptr<probe::PerformProbe>>& dbusProbePointers);
+    bool processConfigurations();
 
-    nlohmann::json& _missingConfigurations;
+    // Merges changes seen during the fetch into it by fetching the affected
+    // objects again, or restarting the fetch for structural changes. Returns
+    // whether there are requests to wait for.
+    bool mergeChanges();
+
+    void fetchComplete();
+    void evaluate();
+    void saveSnapshot() const;
+
+    void enterPhase(Phase next);
+    int64_t phaseMicros(Phase p) const;
+
+    std::flat_set<std::string, std::less<>>& _missingConfigurations;
     std::vector<nlohmann::json> _configurations;
     std::function<void()> _callback;
+    ExposeIndex exposeIndex;
     bool _passed = false;
+    bool cancelled = false;
+    bool speculative = false;
+    bool cached = false;
+    size_t pass = 0;
+    size_t pendingFetches = 0;
+    size_t mergedChanges = 0;
+
+    // probes of the current pass waiting for the D-Bus fetch
+    std::vector<probe::PerformProbe> probes;
+    std::flat_set<std::string, std::less<>> probeInterfaces;
+
+    Phase phase = Phase::collect;
+    std::chrono::steady_clock::time_point scanStart =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point phaseStart;
+    std::array<std::chrono::steady_clock::duration,
+               static_cast<size_t>(Phase::done)>
+        phaseTimes{};
 
     boost::asio::io_context& io;
 };
@@ -80,6 +208,16 @@ namespace detail
 // string) into a list of probe statements. Returns an empty vector on error (a
 // non-string statement); a valid probe is never empty.
 std::vector<std::string> parseProbeCommand(const nlohmann::json& probeField);
+
+// Derive the object path roots under which the objects found by a scan live,
+// so later scans can limit their mapper queries to them. Roots nested in
+// other roots are dropped.
+std::flat_set<std::string, std::less<>> deriveProbeRoots(
+    const MapperGetSubTreeResponse& objects);
+
+// Whether 'path' is one of 'roots' or lies beneath one of them.
+bool pathUnderRoots(const std::flat_set<std::string, std::less<>>& roots,
+                    std::string_view path);
 } // namespace detail
 
 } // namespace scan
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "probe_snapshot.hpp"
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+// bumped whenever the encoding changes, older snapshots are then ignored
+static constexpr uint64_t snapshotVersion = 2;
+
+namespace scan
+{
+
+// Properties are stored as [variant index, value] so they are restored with
+// the exact type they had on D-Bus.
+static nlohmann::json encodeValue(const DBusValueVariant& value)
+{
+    return std::visit(
+        [&value](const auto& v) {
+            return nlohmann::json::array({value.index(), v});
+        },
+        value);
+}
+
+template <size_t I = 0>
+static std::optional<DBusValueVariant> decodeValue(size_t index,
+                                                   const nlohmann::json& value)
+{
+    if constexpr (I < std::variant_size_v<DBusValueVariant>)
+    {
+        if (index != I)
+        {
+            return decodeValue<I + 1>(index, value);
+        }
+        using T = std::variant_alternative_t<I, DBusValueVariant>;
+        T decoded;
+        try
+        {
+            value.get_to(decoded);
+        }
+        catch (const nlohmann::json::exception&)
+        {
+            return std::nullopt;
+        }
+        return DBusValueVariant(std::in_place_index<I>, std::move(decoded));
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+std::vector<uint8_t> ProbeSnapshot::encode() const
+{
+    nlohmann::json::object_t encodedObjects;
+    for (const auto& [path, interfaces] : objects)
+    {
+        nlohmann::json::object_t encodedInterfaces;
+        for (const auto& [interface, properties] : interfaces)
+        {
+            nlohmann::json::object_t encodedProperties;
+            for (const auto& [name, value] : properties)
+            {
+                encodedProperties[name] = encodeValue(value);
+            }
+            encodedInterfaces[interface] = std::move(encodedProperties);
+        }
+        encodedObjects[path] = std::move(encodedInterfaces);
+    }
+
+    nlohmann::json snapshot = {{"Version", snapshotVersion},
+                               {"Objects", std::move(encodedObjects)}};
+    return nlohmann::json::to_cbor(snapshot);
+}
+
+std::optional<ProbeSnapshot> ProbeSnapshot::decode(
+    std::span<const uint8_t> data)
+{
+    nlohmann::json snapshot =
+        nlohmann::json::from_cbor(data.begin(), data.end(), true, false);
+    if (snapshot.is_discarded() || !snapshot.is_object())
+    {
+        return std::nullopt;
+    }
+
+    auto version = snapshot.find("Version");
+    if (version == snapshot.end() || *version != snapshotVersion)
+    {
+        return std::nullopt;
+    }
+
+    auto encodedObjects = snapshot.find("Objects");
+    if (encodedObjects == snapshot.end() || !encodedObjects->is_object())
+    {
+        return std::nullopt;
+    }
+
+    ProbeSnapshot decoded;
+    for (const auto& [path, interfaces] : encodedObjects->items())
+    {
+        if (!interfaces.is_object())
+        {
+            return std::nullopt;
+        }
+        DBusObject& object = decoded.objects[path];
+        for (const auto& [interface, properties] : interfaces.items())
+        {
+            if (!properties.is_object())
+            {
+                return std::nullopt;
+            }
+            DBusInterface& decodedInterface = object[interface];
+            for (const auto& [name, value] : properties.items())
+            {
+                const uint64_t* index =
+                    value.is_array() && value.size() == 2
+                        ? value[0].get_ptr<const uint64_t*>()
+                        : nullptr;
+                if (index == nullptr)
+                {
+                    return std::nullopt;
+                }
+                std::optional<DBusValueVariant> decodedValue =
+                    decodeValue(*index, value[1]);
+                if (!decodedValue)
+                {
+                    return std::nullopt;
+                }
+                decodedInterface.emplace(name, std::move(*decodedValue));
+            }
+        }
+    }
+    return decoded;
+}
+
+std::optional<ProbeSnapshot> ProbeSnapshot::load(
+    const std::filesystem::path& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input.good())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)),
+                              std::istreambuf_iterator<char>());
+    std::optional<ProbeSnapshot> snapshot = decode(data);
+    if (!snapshot)
+    {
+        lg2::error("ignoring invalid probe snapshot {PATH}", "PATH", path);
+    }
+    return snapshot;
+}
+
+bool ProbeSnapshot::save(const std::filesystem::path& path,
+                         std::span<const uint8_t> data)
+{
+    // write to the side so an interrupted write never leaves a torn snapshot
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+    if (!output.good())
+    {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    output.write(reinterpret_cast<const char*>(data.data()),
+                 static_cast<std::streamsize>(data.size()));
+    output.close();
+    if (!output)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    return !ec;
+}
+
+} // namespace scan
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "../utils.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+constexpr const char* probeSnapshotFile =
+    "/var/configuration/probe-objects.cbor";
+
+namespace scan
+{
+
+// The D-Bus objects probed by a scan, persisted so the next boot with the
+// same firmware can evaluate the probes before D-Bus is fully populated.
+struct ProbeSnapshot
+{
+    MapperGetSubTreeResponse objects;
+
+    // @returns  the snapshot in its compact on-disk format
+    std::vector<uint8_t> encode() const;
+
+    // @returns  the snapshot, or nullopt if 'data' is not a valid snapshot
+    static std::optional<ProbeSnapshot> decode(std::span<const uint8_t> data);
+
+    // @returns  the snapshot stored at 'path', or nullopt if there is none
+    static std::optional<ProbeSnapshot> load(const std::filesystem::path& path);
+
+    // @brief   stores 'data', an encoded snapshot, at 'path'
+    // @returns false on error
+    static bool save(const std::filesystem::path& path,
+                     std::span<const uint8_t> data);
+};
+
+} // namespace scan
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "property_locator.hpp"
+
+#include <charconv>
+
+namespace dbus_interface
+{
+
+namespace
+{
+
+std::string unescape(std::string_view token)
+{
+    std::string unescaped;
+    unescaped.reserve(token.size());
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (token[i] == '~' && i + 1 < token.size() &&
+            (token[i + 1] == '0' || token[i + 1] == '1'))
+        {
+            unescaped += token[i + 1] == '0' ? '~' : '/';
+            i++;
+            continue;
+        }
+        unescaped += token[i];
+    }
+    return unescaped;
+}
+
+void appendEscaped(std::string& pointer, std::string_view token)
+{
+    pointer += '/';
+    for (char c : token)
+    {
+        if (c == '~')
+        {
+            pointer += "~0";
+        }
+        else if (c == '/')
+        {
+            pointer += "~1";
+        }
+        else
+        {
+            pointer += c;
+        }
+    }
+}
+
+// @returns  the member or element 'token' of 'json', nullptr if there is none
+template <typename Json>
+Json* child(Json& json, const std::string& token)
+{
+    if (json.is_object())
+    {
+        auto found = json.find(token);
+        return found == json.end() ? nullptr : &*found;
+    }
+    if (json.is_array())
+    {
+        size_t index = 0;
+        const char* end = token.data() + token.size();
+        auto [ptr, ec] = std::from_chars(token.data(), end, index);
+        if (token.empty() || ec != std::errc() || ptr != end ||
+            index >= json.size())
+        {
+            return nullptr;
+        }
+        return &json[index];
+    }
+    return nullptr;
+}
+
+template <typename Json>
+Json* findMember(Json& root, const PropertyLocator::Location& object,
+                 const std::string& key)
+{
+    Json* json = &root;
+    for (const std::string& token : object)
+    {
+        json = child(*json, token);
+        if (json == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    return child(*json, key);
+}
+
+} // namespace
+
+std::shared_ptr<const PropertyLocator::Location> PropertyLocator::locate(
+    std::string_view pointer)
+{
+    auto location = std::make_shared<Location>();
+    while (pointer.starts_with('/'))
+    {
+        pointer.remove_prefix(1);
+        size_t end = pointer.find('/');
+        location->emplace_back(unescape(pointer.substr(0, end)));
+        pointer.remove_prefix(end == std::string_view::npos ? pointer.size()
+                                                            : end);
+    }
+    return location;
+}
+
+const nlohmann::json* PropertyLocator::find(const nlohmann::json& root) const
+{
+    return findMember(root, *object, key);
+}
+
+nlohmann::json* PropertyLocator::find(nlohmann::json& root) const
+{
+    return findMember(root, *object, key);
+}
+
+std::string PropertyLocator::pointer() const
+{
+    std::string pointer;
+    for (const std::string& token : *object)
+    {
+        appendEscaped(pointer, token);
+    }
+    appendEscaped(pointer, key);
+    return pointer;
+}
+
+} // namespace dbus_interface
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dbus_interface
+{
+
+// Where the value of a published property is in the system configuration,
+// which the property is read from and written to rather than keeping a copy
+// of it. The properties of an interface share the location of the object
+// they are members of.
+class PropertyLocator
+{
+  public:
+    // the reference tokens of a JSON pointer to an object
+    using Location = std::vector<std::string>;
+
+    PropertyLocator(std::shared_ptr<const Location> object, std::string key) :
+        object(std::move(object)), key(std::move(key))
+    {}
+
+    // @brief    splits a JSON pointer, e.g. "/record/Exposes/0"
+    static std::shared_ptr<const Location> locate(std::string_view pointer);
+
+    // @returns  the value of the property, nullptr if it is no longer in the
+    //           configuration, e.g. after its record was deleted
+    const nlohmann::json* find(const nlohmann::json& root) const;
+    nlohmann::json* find(nlohmann::json& root) const;
+
+    // @returns  the JSON pointer to the property
+    std::string pointer() const;
+
+  private:
+    std::shared_ptr<const Location> object;
+    std::string key;
+};
+
+// @brief    converts a value of the configuration to the type it is
+//           published with, elements of arrays which don't convert are left
+//           out as when they were published
+// @returns  false if the value isn't of that type
+template <typename PropertyType>
+bool fromJson(const nlohmann::json& json, PropertyType& value)
+{
+    if constexpr (std::is_same_v<PropertyType, bool>)
+    {
+        if (!json.is_boolean())
+        {
+            return false;
+        }
+        value = json.get<bool>();
+    }
+    else if constexpr (std::is_arithmetic_v<PropertyType>)
+    {
+        // whole numbers are published as doubles when they are writable
+        if (!json.is_number())
+        {
+            return false;
+        }
+        value = json.get<PropertyType>();
+    }
+    else if constexpr (std::is_same_v<PropertyType, std::string>)
+    {
+        const std::string* str = json.get_ptr<const std::string*>();
+        if (str == nullptr)
+        {
+            return false;
+        }
+        value = *str;
+    }
+    else
+    {
+        if (!json.is_array())
+        {
+            return false;
+        }
+        value.clear();
+        for (const nlohmann::json& element : json)
+        {
+            typename PropertyType::value_type converted{};
+            if (fromJson(element, converted))
+            {
+                value.emplace_back(std::move(converted));
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace dbus_interface
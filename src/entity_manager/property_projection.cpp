@@ -0,0 +1,389 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "property_projection.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <regex>
+#include <type_traits>
+
+namespace scan
+{
+
+static std::string toLower(std::string_view str)
+{
+    std::string lower(str);
+    std::ranges::transform(lower, lower.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return lower;
+}
+
+static bool isIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+void PropertyProjection::addProbe(std::string_view probe)
+{
+    // same parsing as doProbe, a statement which doesn't parse never matches
+    // and so doesn't refer to anything
+    const static std::regex command(R"(\((.*)\))");
+    std::string statement(probe);
+    std::smatch match;
+    if (!std::regex_search(statement, match, command))
+    {
+        return;
+    }
+    std::string commandStr = *(match.begin() + 1);
+    std::ranges::replace(commandStr, '\'', '"');
+    replaceAll(commandStr, R"(\)", R"(\\)");
+
+    auto json = nlohmann::json::parse(commandStr, nullptr, false, true);
+    const nlohmann::json::object_t* matches =
+        json.get_ptr<const nlohmann::json::object_t*>();
+    if (matches == nullptr)
+    {
+        return;
+    }
+    for (const auto& [property, _] : *matches)
+    {
+        probeProperties.emplace(property);
+    }
+}
+
+void PropertyProjection::addTemplates(const nlohmann::json& configuration)
+{
+    const std::string* str = configuration.get_ptr<const std::string*>();
+    if (str == nullptr)
+    {
+        if (configuration.is_structured())
+        {
+            for (const auto& value : configuration)
+            {
+                addTemplates(value);
+            }
+        }
+        return;
+    }
+
+    for (size_t pos = str->find('$'); pos != std::string::npos;
+         pos = str->find('$', pos))
+    {
+        pos++;
+        size_t end = pos;
+        while (end < str->size() && isIdentifierChar((*str)[end]))
+        {
+            end++;
+        }
+        if (end != pos)
+        {
+            templateTokens.emplace(
+                toLower(std::string_view(*str).substr(pos, end - pos)));
+        }
+    }
+}
+
+bool PropertyProjection::referenced(std::string_view property) const
+{
+    if (probeProperties.contains(property))
+    {
+        return true;
+    }
+
+    // A template refers to the property if "$<property>" occurs in it,
+    // which is the case if the property is a prefix of one of the tokens.
+    // Tokens with a given prefix sort right after the prefix itself.
+    std::string lower = toLower(property);
+    auto token = templateTokens.lower_bound(lower);
+    return token != templateTokens.end() && token->starts_with(lower);
+}
+
+// FNV-1a, cheap and good enough to tell values apart
+static constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325;
+static constexpr uint64_t fnvPrime = 0x100000001b3;
+
+static void digestBytes(uint64_t& digest, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        digest ^= bytes[i];
+        digest *= fnvPrime;
+    }
+}
+
+// Digests the next complete value of the message, without converting it.
+// Returns false on error.
+static bool digestValue(sd_bus_message* m, uint64_t& digest)
+{
+    char type = 0;
+    const char* contents = nullptr;
+    if (sd_bus_message_peek_type(m, &type, &contents) <= 0)
+    {
+        return false;
+    }
+    digestBytes(digest, &type, 1);
+
+    switch (type)
+    {
+        case SD_BUS_TYPE_ARRAY:
+        case SD_BUS_TYPE_VARIANT:
+        case SD_BUS_TYPE_STRUCT:
+        case SD_BUS_TYPE_DICT_ENTRY:
+        {
+            digestBytes(digest, contents, std::strlen(contents));
+            if (sd_bus_message_enter_container(m, type, contents) < 0)
+            {
+                return false;
+            }
+            int r = 0;
+            while ((r = sd_bus_message_peek_type(m, nullptr, nullptr)) > 0)
+            {
+                if (!digestValue(m, digest))
+                {
+                    return false;
+                }
+            }
+            return r == 0 && sd_bus_message_exit_container(m) >= 0;
+        }
+        case SD_BUS_TYPE_STRING:
+        case SD_BUS_TYPE_OBJECT_PATH:
+        case 'g': // signature
+        {
+            const char* str = nullptr;
+            if (sd_bus_message_read_basic(m, type, &str) < 0)
+            {
+                return false;
+            }
+            digestBytes(digest, str, std::strlen(str));
+            return true;
+        }
+        default:
+        {
+            // all other basic types fit into 8 bytes
+            uint64_t value = 0;
+            if (sd_bus_message_read_basic(m, type, &value) < 0)
+            {
+                return false;
+            }
+            digestBytes(digest, &value, sizeof(value));
+            return true;
+        }
+    }
+}
+
+// The D-Bus type codes of the alternatives of DBusValueVariant.
+template <typename T>
+static constexpr char typeCode()
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return SD_BUS_TYPE_STRING;
+    }
+    else if constexpr (std::is_same_v<T, int64_t>)
+    {
+        return 'x';
+    }
+    else if constexpr (std::is_same_v<T, uint64_t>)
+    {
+        return 't';
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return 'd';
+    }
+    else if constexpr (std::is_same_v<T, int32_t>)
+    {
+        return 'i';
+    }
+    else if constexpr (std::is_same_v<T, uint32_t>)
+    {
+        return 'u';
+    }
+    else if constexpr (std::is_same_v<T, int16_t>)
+    {
+        return 'n';
+    }
+    else if constexpr (std::is_same_v<T, uint16_t>)
+    {
+        return 'q';
+    }
+    else if constexpr (std::is_same_v<T, uint8_t>)
+    {
+        return 'y';
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, bool>);
+        return 'b';
+    }
+}
+
+// Digests a decoded value like digestValue() does the value in the message.
+template <typename T>
+static void digestDecoded(uint64_t& digest, const T& value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        char type = SD_BUS_TYPE_STRING;
+        digestBytes(digest, &type, 1);
+        digestBytes(digest, value.data(), value.size());
+    }
+    else if constexpr (requires { value.begin(); })
+    {
+        char type = SD_BUS_TYPE_ARRAY;
+        char element = typeCode<typename T::value_type>();
+        digestBytes(digest, &type, 1);
+        digestBytes(digest, &element, 1);
+        for (const auto& element : value)
+        {
+            digestDecoded(digest, element);
+        }
+    }
+    else
+    {
+        char type = typeCode<T>();
+        digestBytes(digest, &type, 1);
+        // sd_bus_message_read_basic() stores booleans as int
+        using Stored = std::conditional_t<std::is_same_v<T, bool>, int, T>;
+        Stored stored = value;
+        uint64_t bytes = 0;
+        std::memcpy(&bytes, &stored, sizeof(stored));
+        digestBytes(digest, &bytes, sizeof(bytes));
+    }
+}
+
+// The signature of the variant holding 'value' in a GetAll reply.
+template <typename T>
+static std::string variantSignature()
+{
+    if constexpr (std::is_same_v<T, std::string> ||
+                  !requires(T value) { value.begin(); })
+    {
+        return {typeCode<T>()};
+    }
+    else
+    {
+        return {SD_BUS_TYPE_ARRAY, typeCode<typename T::value_type>()};
+    }
+}
+
+void PropertyProjection::project(DBusInterface& properties) const
+{
+    for (auto& [name, value] : properties)
+    {
+        if (referenced(name))
+        {
+            continue;
+        }
+        uint64_t digest = fnvOffsetBasis;
+        std::visit(
+            [&digest](const auto& decoded) {
+                using T = std::decay_t<decltype(decoded)>;
+                char type = SD_BUS_TYPE_VARIANT;
+                digestBytes(digest, &type, 1);
+                std::string signature = variantSignature<T>();
+                digestBytes(digest, signature.data(), signature.size());
+                digestDecoded(digest, decoded);
+            },
+            value);
+        value = digest;
+    }
+}
+
+bool PropertyProjection::decode(sdbusplus::message_t& reply,
+                                DBusInterface& properties) const
+{
+    sd_bus_message* m = reply.get();
+    if (sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sv}") < 0)
+    {
+        return false;
+    }
+
+    int r = 0;
+    while ((r = sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                               "sv")) > 0)
+    {
+        const char* name = nullptr;
+        if (sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &name) < 0)
+        {
+            return false;
+        }
+
+        if (referenced(name))
+        {
+            DBusValueVariant value;
+            try
+            {
+                reply.read(value);
+            }
+            catch (const sdbusplus::exception_t&)
+            {
+                return false;
+            }
+            properties.insert_or_assign(name, std::move(value));
+        }
+        else
+        {
+            uint64_t digest = fnvOffsetBasis;
+            if (!digestValue(m, digest))
+            {
+                return false;
+            }
+            properties.insert_or_assign(name, digest);
+        }
+
+        if (sd_bus_message_exit_container(m) < 0)
+        {
+            return false;
+        }
+    }
+    return r == 0 && sd_bus_message_exit_container(m) >= 0;
+}
+
+bool PropertyProjection::decodeAll(sdbusplus::message_t& reply,
+                                   DBusInterface& properties)
+{
+    sd_bus_message* m = reply.get();
+    if (sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sv}") < 0)
+    {
+        return false;
+    }
+
+    int r = 0;
+    while ((r = sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                               "sv")) > 0)
+    {
+        const char* name = nullptr;
+        if (sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &name) < 0)
+        {
+            return false;
+        }
+        DBusValueVariant value;
+        try
+        {
+            reply.read(value);
+        }
+        catch (const sdbusplus::exception_t&)
+        {
+            return false;
+        }
+        properties.insert_or_assign(name, std::move(value));
+
+        if (sd_bus_message_exit_container(m) < 0)
+        {
+            return false;
+        }
+    }
+    return r == 0 && sd_bus_message_exit_container(m) >= 0;
+}
+
+} // namespace scan
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "../utils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <flat_set>
+#include <string>
+#include <string_view>
+
+namespace scan
+{
+
+// The properties of probed interfaces which configurations refer to, either
+// as a probe match or as a $Property template. Only those are decoded when
+// fetching objects, the others are kept as a digest of their value so they
+// still contribute to the identity of a record.
+class PropertyProjection
+{
+  public:
+    // @brief        collects the properties matched by a D-Bus probe
+    // @param probe  statement like Interface({'Property': 'Value'})
+    void addProbe(std::string_view probe);
+
+    // @brief  collects the $Property templates of a configuration
+    void addTemplates(const nlohmann::json& configuration);
+
+    // @returns  whether the value of 'property' may be needed
+    bool referenced(std::string_view property) const;
+
+    // @returns  whether a probe matches on the value of 'property'
+    bool probed(std::string_view property) const
+    {
+        return probeProperties.contains(property);
+    }
+
+    // @brief    decodes the reply of a GetAll call, see 'referenced'
+    // @returns  false if the reply is malformed
+    bool decode(sdbusplus::message_t& reply, DBusInterface& properties) const;
+
+    // @brief    decodes the reply of a GetAll call with every property
+    // @returns  false if the reply is malformed, or has a property
+    //           DBusValueVariant can't hold
+    static bool decodeAll(sdbusplus::message_t& reply,
+                          DBusInterface& properties);
+
+    // @brief  replaces the properties of a reply decoded by 'decodeAll'
+    //         which aren't referenced by their digest, so they are the same
+    //         as if decoded by 'decode'
+    void project(DBusInterface& properties) const;
+
+  private:
+    // property names matched by probes, compared exactly
+    std::flat_set<std::string, std::less<>> probeProperties;
+
+    // lower case identifiers following a '$', templates are matched
+    // case-insensitively and on a prefix of the identifier
+    std::flat_set<std::string, std::less<>> templateTokens;
+};
+
+} // namespace scan
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "publish_priority.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace dbus_interface
+{
+
+namespace
+{
+
+// the types of the Exposes records phosphor-pid-control and the power supply
+// monitoring wait for
+constexpr std::array<std::string_view, 10> criticalTypes = {
+    "AspeedFan",   "FanRedundancy", "HPEFan", "I2CFan",   "NuvotonFan",
+    "PSUPresence", "PURedundancy",  "Pid",    "Pid.Zone", "Stepwise"};
+
+} // namespace
+
+PublishPriority publishPriority(const nlohmann::json& record)
+{
+    const nlohmann::json::object_t* object =
+        record.get_ptr<const nlohmann::json::object_t*>();
+    if (object == nullptr)
+    {
+        return PublishPriority::normal;
+    }
+
+    auto configured = object->find("PublishPriority");
+    if (configured != object->end())
+    {
+        const std::string* priority =
+            configured->second.get_ptr<const std::string*>();
+        if (priority != nullptr && *priority == "Critical")
+        {
+            return PublishPriority::critical;
+        }
+        if (priority != nullptr && *priority == "Normal")
+        {
+            return PublishPriority::normal;
+        }
+        lg2::error("invalid PublishPriority {PRIORITY}", "PRIORITY",
+                   configured->second.dump());
+    }
+
+    auto exposes = object->find("Exposes");
+    if (exposes == object->end() || !exposes->second.is_array())
+    {
+        return PublishPriority::normal;
+    }
+    for (const nlohmann::json& item : exposes->second)
+    {
+        auto type = item.find("Type");
+        if (type == item.end())
+        {
+            continue;
+        }
+        const std::string* typeName = type->get_ptr<const std::string*>();
+        if (typeName != nullptr &&
+            std::ranges::binary_search(criticalTypes, *typeName))
+        {
+            return PublishPriority::critical;
+        }
+    }
+    return PublishPriority::normal;
+}
+
+} // namespace dbus_interface
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+
+namespace dbus_interface
+{
+
+// The boards of a configuration are published by priority. Those the fan and
+// power control depend on go out first, the others follow a slice at a time
+// in between handling other D-Bus traffic.
+enum class PublishPriority : uint8_t
+{
+    critical,
+    normal,
+};
+
+// @brief    the priority a board is published with, which its record sets
+//           with "PublishPriority", or else the types it exposes imply
+// @param    record  the record of the board in the system configuration
+// @returns  PublishPriority::normal for anything which isn't a record
+PublishPriority publishPriority(const nlohmann::json& record);
+
+} // namespace dbus_interface
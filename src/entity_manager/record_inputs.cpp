@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "record_inputs.hpp"
+
+namespace scan
+{
+
+void RecordInputs::set(const std::string& record, std::flat_set<Input> inputs)
+{
+    remove(record);
+    for (const Input& input : inputs)
+    {
+        recordsOfInput[input].emplace(record);
+    }
+    if (!inputs.empty())
+    {
+        inputsOfRecord.emplace(record, std::move(inputs));
+    }
+}
+
+void RecordInputs::remove(const std::string& record)
+{
+    staleRecords.erase(record);
+
+    auto found = inputsOfRecord.find(record);
+    if (found == inputsOfRecord.end())
+    {
+        return;
+    }
+    for (const Input& input : found->second)
+    {
+        auto records = recordsOfInput.find(input);
+        if (records == recordsOfInput.end())
+        {
+            continue;
+        }
+        records->second.erase(record);
+        if (records->second.empty())
+        {
+            recordsOfInput.erase(records);
+        }
+    }
+    inputsOfRecord.erase(found);
+}
+
+bool RecordInputs::changed(std::string_view path, std::string_view interface,
+                           std::string_view property)
+{
+    auto records = recordsOfInput.find(Input{
+        std::string(path), std::string(interface), std::string(property)});
+    if (records == recordsOfInput.end())
+    {
+        return false;
+    }
+    staleRecords.insert(records->second.begin(), records->second.end());
+    return true;
+}
+
+} // namespace scan
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <flat_set>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace scan
+{
+
+// The D-Bus properties each record of the system configuration was templated
+// from, so a change of a property only re-templates the records depending on
+// it, and a change of a property no record depends on doesn't need a scan.
+class RecordInputs
+{
+  public:
+    // path, interface, property
+    using Input = std::tuple<std::string, std::string, std::string>;
+
+    // @brief  replaces the inputs of a record which was (re-)instantiated,
+    //         the record is no longer stale
+    void set(const std::string& record, std::flat_set<Input> inputs);
+
+    // @brief  forgets a record which was removed from the configuration
+    void remove(const std::string& record);
+
+    // @brief    a property changed, marks the records depending on it stale
+    // @returns  whether any record depends on the property
+    bool changed(std::string_view path, std::string_view interface,
+                 std::string_view property);
+
+    // @returns  whether an input of the record changed since it was
+    //           templated, so it has to be instantiated again
+    bool stale(std::string_view record) const
+    {
+        return staleRecords.contains(record);
+    }
+
+  private:
+    std::map<std::string, std::flat_set<Input>, std::less<>> inputsOfRecord;
+    std::map<Input, std::flat_set<std::string, std::less<>>, std::less<>>
+        recordsOfInput;
+    std::flat_set<std::string, std::less<>> staleRecords;
+};
+
+} // namespace scan
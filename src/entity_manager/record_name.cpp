@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "record_name.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <functional>
+#include <type_traits>
+
+namespace scan
+{
+
+namespace
+{
+
+constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+// little endian regardless of the host
+uint64_t read64(const uint8_t* bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t read32(const uint8_t* bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t mixLane(uint64_t lane, uint64_t input)
+{
+    lane += input * prime2;
+    return std::rotl(lane, 31) * prime1;
+}
+
+uint64_t mergeRound(uint64_t hash, uint64_t lane)
+{
+    hash ^= mixLane(0, lane);
+    return hash * prime1 + prime4;
+}
+
+// The properties are fed with their type and sizes, so different values
+// never encode to the same bytes, e.g. an int32_t and an int64_t of the same
+// value, or ["a", "bc"] and ["ab", "c"].
+void feed(RecordHasher& hasher, const DBusValueVariant& value)
+{
+    hasher.update(static_cast<uint64_t>(value.index()));
+    std::visit(
+        [&hasher](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                hasher.update(v.size());
+                hasher.update(v);
+            }
+            else if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+            {
+                hasher.update(v.size());
+                hasher.update(std::string_view(
+                    reinterpret_cast<const char*>(v.data()), v.size()));
+            }
+            else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+            {
+                hasher.update(v.size());
+                for (const std::string& str : v)
+                {
+                    hasher.update(str.size());
+                    hasher.update(str);
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                hasher.update(std::bit_cast<uint64_t>(v));
+            }
+            else
+            {
+                // sign extended, the type is told apart by the index
+                hasher.update(static_cast<uint64_t>(v));
+            }
+        },
+        value);
+}
+
+} // namespace
+
+void RecordHasher::update(std::string_view bytes)
+{
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    size_t size = bytes.size();
+    total += size;
+
+    if (buffered > 0)
+    {
+        size_t taken = std::min(size, buffer.size() - buffered);
+        std::copy_n(data, taken, buffer.begin() + buffered);
+        buffered += taken;
+        data += taken;
+        size -= taken;
+        if (buffered < buffer.size())
+        {
+            return;
+        }
+        consumeStripe(buffer.data());
+        buffered = 0;
+    }
+
+    for (; size >= buffer.size(); data += buffer.size(), size -= buffer.size())
+    {
+        consumeStripe(data);
+    }
+
+    std::copy_n(data, size, buffer.begin());
+    buffered = size;
+}
+
+void RecordHasher::update(uint64_t value)
+{
+    std::array<char, 8> bytes{};
+    for (size_t i = 0; i < bytes.size(); i++)
+    {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    update(std::string_view(bytes.data(), bytes.size()));
+}
+
+void RecordHasher::consumeStripe(const uint8_t* stripe)
+{
+    for (size_t i = 0; i < lanes.size(); i++)
+    {
+        lanes[i] = mixLane(lanes[i], read64(stripe + 8 * i));
+    }
+}
+
+uint64_t RecordHasher::digest() const
+{
+    uint64_t hash = 0;
+    if (total >= buffer.size())
+    {
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) +
+               std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+        for (uint64_t lane : lanes)
+        {
+            hash = mergeRound(hash, lane);
+        }
+    }
+    else
+    {
+        hash = prime5;
+    }
+    hash += total;
+
+    const uint8_t* tail = buffer.data();
+    const uint8_t* end = buffer.data() + buffered;
+    for (; end - tail >= 8; tail += 8)
+    {
+        hash ^= mixLane(0, read64(tail));
+        hash = std::rotl(hash, 27) * prime1 + prime4;
+    }
+    if (end - tail >= 4)
+    {
+        hash ^= read32(tail) * prime1;
+        hash = std::rotl(hash, 23) * prime2 + prime3;
+        tail += 4;
+    }
+    for (; tail < end; tail++)
+    {
+        hash ^= *tail * prime5;
+        hash = std::rotl(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::string recordName(const DBusInterface& probe,
+                       const std::string& probeName)
+{
+    if (probe.empty())
+    {
+        return probeName;
+    }
+
+    // the flat_map keeps the properties in alphabetical order
+    RecordHasher hasher;
+    hasher.update(probeName.size());
+    hasher.update(probeName);
+    for (const auto& [name, value] : probe)
+    {
+        hasher.update(name.size());
+        hasher.update(name);
+        feed(hasher, value);
+    }
+
+    return std::format("{:016x}", hasher.digest());
+}
+
+std::string legacyRecordName(const DBusInterface& probe,
+                             const std::string& probeName)
+{
+    if (probe.empty())
+    {
+        return probeName;
+    }
+
+    // use an array so alphabetical order from the flat_map is maintained
+    auto device = nlohmann::json::array();
+    for (const auto& devPair : probe)
+    {
+        device.push_back(devPair.first);
+        std::visit([&device](auto&& v) { device.push_back(v); },
+                   devPair.second);
+    }
+
+    return std::to_string(std::hash<std::string>{}(probeName + device.dump()));
+}
+
+bool isLegacyRecordName(std::string_view name)
+{
+    // recordName() makes 16 hexadecimal digits, std::to_string() of a hash
+    // rarely has exactly 16 digits
+    return !name.empty() && name.size() != 16 &&
+           std::ranges::all_of(name,
+                               [](char c) { return c >= '0' && c <= '9'; });
+}
+
+} // namespace scan
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "../utils.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace scan
+{
+
+// 64-bit xxHash (XXH64) with a zero seed, fed incrementally. The result only
+// depends on the bytes fed, so it is the same on every build and platform.
+class RecordHasher
+{
+  public:
+    void update(std::string_view bytes);
+    void update(uint64_t value);
+
+    uint64_t digest() const;
+
+  private:
+    void consumeStripe(const uint8_t* stripe);
+
+    std::array<uint64_t, 4> lanes{
+        0x9E3779B185EBCA87ULL + 0xC2B2AE3D27D4EB4FULL,
+        0xC2B2AE3D27D4EB4FULL, 0, 0 - 0x9E3779B185EBCA87ULL};
+    std::array<uint8_t, 32> buffer{};
+    size_t buffered = 0;
+    uint64_t total = 0;
+};
+
+// @brief            names the record of the device found by a probe, the
+//                   name the record is persisted under across reboots
+// @param probe      properties of the interface the probe matched
+// @param probeName  name of the configuration that probed the device
+// @returns          16 hexadecimal digits hashing the probe name and the
+//                   properties, or the probe name if there are no properties
+std::string recordName(const DBusInterface& probe,
+                       const std::string& probeName);
+
+// @brief   the name records were persisted under before recordName(), a
+//          std::hash of the properties dumped as JSON
+// @returns the legacy name, or the probe name if there are no properties
+std::string legacyRecordName(const DBusInterface& probe,
+                             const std::string& probeName);
+
+// @returns  whether 'name' may have been made by legacyRecordName() rather
+//           than recordName(), i.e. whether persisted configurations have to
+//           be looked up by their legacy name too
+bool isLegacyRecordName(std::string_view name);
+
+} // namespace scan
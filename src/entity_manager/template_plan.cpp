@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "template_plan.hpp"
+
+#include "../variant_visitors.hpp"
+#include "expression.hpp"
+#include "utils.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace em_utils
+{
+
+TemplateProperties::TemplateProperties(const DBusObject& object,
+                                       size_t index) :
+    deviceIndex(index), indexValue(index)
+{
+    for (const auto& [_, interface] : object)
+    {
+        add(interface);
+    }
+}
+
+TemplateProperties::TemplateProperties(const DBusInterface& interface,
+                                       size_t index) :
+    deviceIndex(index), indexValue(index)
+{
+    add(interface);
+}
+
+void TemplateProperties::add(const DBusInterface& interface)
+{
+    // $index is replaced before the properties of the first interface
+    if (interfaceList.empty())
+    {
+        properties.try_emplace("index", Property{0, 0, 5, &indexValue, true});
+    }
+
+    size_t interfaceIdx = interfaceList.size();
+    interfaceList.push_back(&interface);
+    for (const auto& [name, value] : interface)
+    {
+        properties.try_emplace(
+            toLowerCopy(name),
+            Property{properties.size(), interfaceIdx, name.size(), &value,
+                     false});
+    }
+}
+
+const TemplateProperties::Property* TemplateProperties::resolve(
+    std::string_view token) const
+{
+    const Property* found = nullptr;
+    for (size_t size = 1; size <= token.size(); size++)
+    {
+        auto property = properties.find(token.substr(0, size));
+        if (property != properties.end() &&
+            (found == nullptr || property->second.order < found->order))
+        {
+            found = &property->second;
+        }
+    }
+    return found;
+}
+
+static bool isIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+static bool isMathChar(char c)
+{
+    constexpr std::array<char, 5> mathChars = {'+', '-', '%', '*', '/'};
+    return std::ranges::find(mathChars, c) != mathChars.end();
+}
+
+// whether 'str' continues an expression with an operand containing a '$'
+static bool continuesWithTemplate(std::string_view str)
+{
+    size_t pos = str.starts_with(' ') ? 1 : 0;
+    if (pos >= str.size() || !isMathChar(str[pos]))
+    {
+        return false;
+    }
+    pos = str.find_first_not_of(' ', pos + 1);
+    if (pos == std::string_view::npos)
+    {
+        return false;
+    }
+    std::string_view operand = str.substr(pos, str.find(' ', pos) - pos);
+    return operand.find('$') != std::string_view::npos;
+}
+
+TemplatePlan::TemplatePlan(std::string_view str)
+{
+    size_t literalStart = 0;
+    for (size_t pos = str.find('$'); pos != std::string_view::npos;)
+    {
+        size_t begin = pos + 1;
+        size_t end = begin;
+        while (end < str.size() && isIdentifierChar(str[end]))
+        {
+            end++;
+        }
+        if (end == begin)
+        {
+            // a lone '$' never matches a property
+            pos = str.find('$', begin);
+            continue;
+        }
+
+        if (pos > literalStart)
+        {
+            Segment literal;
+            literal.text = str.substr(literalStart, pos - literalStart);
+            segments.push_back(std::move(literal));
+        }
+
+        Segment variable;
+        variable.text = str.substr(begin, end - begin);
+        variable.variable = true;
+        variable.token = toLowerCopy(variable.text);
+
+        // like templateCharReplaceOneProperty, an operator after the
+        // character following the template starts an expression
+        bool exact = pos == 0 && end == str.size();
+        size_t next = end + 1;
+        if (!exact && next < str.size() && isMathChar(str[next]))
+        {
+            std::string_view rest = str.substr(next);
+            auto expression = expression::Expression::parse(rest);
+            size_t consumed = expression ? expression->second : 0;
+            if (!expression)
+            {
+                lg2::error("Syntax error on template replacement of {STR}",
+                           "STR", str);
+            }
+            else
+            {
+                variable.math = std::move(expression->first);
+                variable.mathText = str.substr(end, next + consumed - end);
+                end = next + consumed;
+            }
+            // an operand which is a template itself depends on the order the
+            // properties are replaced in
+            if (continuesWithTemplate(rest.substr(consumed)))
+            {
+                sequential = true;
+            }
+        }
+        segments.push_back(std::move(variable));
+
+        literalStart = end;
+        pos = str.find('$', end);
+    }
+
+    if (literalStart < str.size())
+    {
+        Segment literal;
+        literal.text = str.substr(literalStart);
+        segments.push_back(std::move(literal));
+    }
+}
+
+static void setNumberOrString(nlohmann::json& value, const std::string& str)
+{
+    const std::optional<uint64_t> number = parseAsNumber(str);
+    if (number)
+    {
+        value = *number;
+    }
+    else
+    {
+        value = str;
+    }
+}
+
+bool TemplatePlan::expand(const TemplateProperties& properties,
+                          nlohmann::json& value) const
+{
+    // without interfaces, templateCharReplace doesn't touch the string
+    if (properties.interfaces().empty())
+    {
+        return true;
+    }
+    if (sequential)
+    {
+        return false;
+    }
+
+    using Property = TemplateProperties::Property;
+    std::vector<const Property*> resolved(segments.size(), nullptr);
+    for (size_t i = 0; i < segments.size(); i++)
+    {
+        if (!segments[i].variable)
+        {
+            continue;
+        }
+        resolved[i] = properties.resolve(segments[i].token);
+        // a shorter property leaves the rest of the identifier in the string,
+        // which later properties may match
+        if (resolved[i] != nullptr &&
+            resolved[i]->nameSize != segments[i].token.size())
+        {
+            return false;
+        }
+    }
+
+    // an expression only applies to the first occurrence of its property
+    for (size_t i = 0; i < segments.size(); i++)
+    {
+        if (segments[i].math && resolved[i] != nullptr &&
+            std::ranges::count(resolved, resolved[i]) > 1)
+        {
+            return false;
+        }
+    }
+
+    // the whole string is the template, it takes the type of the property
+    if (segments.size() == 1 && !segments[0].math && resolved[0] != nullptr &&
+        !resolved[0]->isIndex)
+    {
+        const DBusValueVariant& property = *resolved[0]->value;
+        const std::string* str = std::get_if<std::string>(&property);
+        if (str != nullptr)
+        {
+            if (str->find('$') != std::string::npos)
+            {
+                return false;
+            }
+            // the following interfaces still convert the string
+            if (resolved[0]->interface + 1 < properties.interfaces().size())
+            {
+                setNumberOrString(value, *str);
+                return true;
+            }
+        }
+        std::visit([&value](const auto& val) { value = val; }, property);
+        return true;
+    }
+
+    std::string result;
+    for (size_t i = 0; i < segments.size(); i++)
+    {
+        const Segment& segment = segments[i];
+        if (!segment.variable)
+        {
+            result += segment.text;
+            continue;
+        }
+        if (resolved[i] == nullptr)
+        {
+            result.append("$").append(segment.text).append(segment.mathText);
+            continue;
+        }
+
+        std::optional<int64_t> number;
+        if (segment.math)
+        {
+            number = std::visit(VariantToInt64Visitor(), *resolved[i]->value);
+            if (!number)
+            {
+                lg2::error("Template {STR} does math on a property which "
+                           "isn't a number",
+                           "STR", segment.text);
+            }
+        }
+        if (number)
+        {
+            result += std::to_string(segment.math->evaluate(*number));
+            continue;
+        }
+
+        std::string replaced =
+            std::visit(VariantToStringVisitor(), *resolved[i]->value);
+        // the string would change under the properties replaced after this
+        // one
+        if (replaced.find('$') != std::string::npos ||
+            (replaced.empty() && segments.size() > 1))
+        {
+            return false;
+        }
+        result.append(replaced).append(segment.mathText);
+    }
+
+    setNumberOrString(value, result);
+    return true;
+}
+
+void TemplatePlans::add(const nlohmann::json& configuration)
+{
+    const std::string* str = configuration.get_ptr<const std::string*>();
+    if (str == nullptr)
+    {
+        if (configuration.is_structured())
+        {
+            for (const auto& value : configuration)
+            {
+                add(value);
+            }
+        }
+        return;
+    }
+
+    if (str->find('$') != std::string::npos && !plans.contains(*str))
+    {
+        plans.emplace(*str, TemplatePlan(*str));
+    }
+}
+
+const TemplatePlan* TemplatePlans::find(std::string_view str) const
+{
+    auto plan = plans.find(str);
+    return plan == plans.end() ? nullptr : &plan->second;
+}
+
+} // namespace em_utils
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include "../utils.hpp"
+#include "expression.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <flat_map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace em_utils
+{
+
+// The properties of a probed object that $Property templates are replaced
+// with, along with the index of the device. Built once per device, so
+// expanding a template only looks up the properties it refers to.
+class TemplateProperties
+{
+  public:
+    TemplateProperties(const DBusObject& object, size_t index);
+    TemplateProperties(const DBusInterface& interface, size_t index);
+
+    // refers to its own members
+    TemplateProperties(const TemplateProperties&) = delete;
+    TemplateProperties& operator=(const TemplateProperties&) = delete;
+
+    struct Property
+    {
+        // position in the order templateCharReplace tries the properties
+        size_t order;
+        // index of the interface the property is on
+        size_t interface;
+        size_t nameSize;
+        const DBusValueVariant* value;
+        bool isIndex;
+    };
+
+    // @brief        finds the property "$<token>" is replaced with, which is
+    //               the first one whose name is a prefix of the token when
+    //               ignoring case
+    // @param token  lower case identifier following a '$'
+    // @returns      the property, or nullptr if there is none
+    const Property* resolve(std::string_view token) const;
+
+    const std::vector<const DBusInterface*>& interfaces() const
+    {
+        return interfaceList;
+    }
+
+    size_t index() const
+    {
+        return deviceIndex;
+    }
+
+  private:
+    void add(const DBusInterface& interface);
+
+    std::vector<const DBusInterface*> interfaceList;
+    size_t deviceIndex;
+    DBusValueVariant indexValue;
+
+    // lower case property name -> first property with that name
+    std::flat_map<std::string, Property, std::less<>> properties;
+};
+
+// A configuration string split at its $Property templates, so expanding it
+// for a device is a single pass over its segments.
+class TemplatePlan
+{
+  public:
+    explicit TemplatePlan(std::string_view str);
+
+    // @brief    replaces the templates of the string with 'properties'
+    // @param    value  receives the string, or the number or exact property
+    //                  value it expands to
+    // @returns  false if the string can't be expanded in a single pass, the
+    //           caller then has to fall back to replacing one property at
+    //           a time
+    bool expand(const TemplateProperties& properties,
+                nlohmann::json& value) const;
+
+  private:
+    struct Segment
+    {
+        // text of a literal, or the identifier following the '$'
+        std::string text;
+        bool variable = false;
+        // lower case identifier
+        std::string token;
+        // arithmetic following the template like the "+ 1" of "$bus + 1"
+        std::optional<expression::Expression> math;
+        // text taken by the character before the expression and the
+        // expression itself
+        std::string mathText;
+    };
+
+    std::vector<Segment> segments;
+
+    // the string relies on corner cases of the sequential replacement
+    bool sequential = false;
+};
+
+// Plans of the templated strings of the loaded configurations, keyed by
+// their text.
+class TemplatePlans
+{
+  public:
+    // @brief  compiles the templated strings of a configuration
+    void add(const nlohmann::json& configuration);
+
+    // @returns  the plan of 'str', or nullptr if it wasn't compiled
+    const TemplatePlan* find(std::string_view str) const;
+
+  private:
+    std::flat_map<std::string, TemplatePlan, std::less<>> plans;
+};
+
+} // namespace em_utils
@@ -4,6 +4,7 @@
 #include "../utils.hpp"
 #include "../variant_visitors.hpp"
 #include "expression.hpp"
+#include "template_plan.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus/match.hpp>
@@ -163,23 +164,9 @@ std::optional<std::string> templateCharReplace(
     nlohmann::json& value, const DBusObject& object, const size_t index,
     const std::optional<std::string>& replaceStr, bool handleLeftOver)
 {
-    for (const auto& [_, interface] : object)
-    {
-        auto ret = templateCharReplace(value, interface, index, replaceStr);
-        if (ret)
-        {
-            if (handleLeftOver)
-            {
-                handleLeftOverTemplateVars(value);
-            }
-            return ret;
-        }
-    }
-    if (handleLeftOver)
-    {
-        handleLeftOverTemplateVars(value);
-    }
-    return std::nullopt;
+    const TemplateProperties properties(object, index);
+    return templateCharReplace(value, properties, TemplatePlans(), replaceStr,
+                               handleLeftOver);
 }
 
 static bool templateCharReplaceOneProperty(
@@ -206,57 +193,44 @@ static bool templateCharReplaceOneProperty(
     constexpr const std::array<char, 5> mathChars = {'+', '-', '%', '*', '/'};
     size_t nextItemIdx = start + templateName.size() + 1;
 
-    if (nextItemIdx > str.size() ||
-        std::find(mathChars.begin(), mathChars.end(), str.at(nextItemIdx)) ==
-            mathChars.end())
-    {
-        std::string val = std::visit(VariantToStringVisitor(), propValue);
-        iReplaceAll(str, templateName, val);
-        return false;
-    }
-
-    // save the prefix
-    std::string prefix = str.substr(0, start);
-
-    // operate on the rest
-    std::string end = str.substr(nextItemIdx);
-
-    std::vector<std::string> splitResult = split(end, ' ');
-
-    // need at least 1 operation and number
-    if (splitResult.size() < 2)
+    std::optional<std::pair<expression::Expression, size_t>> expr;
+    if (nextItemIdx < str.size() &&
+        std::ranges::find(mathChars, str[nextItemIdx]) != mathChars.end())
     {
-        lg2::error("Syntax error on template replacement of {STR}", "STR", str);
-        for (const std::string& data : splitResult)
+        expr = expression::Expression::parse(
+            std::string_view(str).substr(nextItemIdx));
+        if (!expr)
         {
-            lg2::error("{SPLIT} ", "SPLIT", data);
+            lg2::error("Syntax error on template replacement of {STR}", "STR",
+                       str);
         }
-        lg2::error("");
-        return false;
     }
 
-    // we assume that the replacement is a number, because we can
-    // only do math on numbers.. we might concatenate strings in the
+    // we can only do math on numbers.. we might concatenate strings in the
     // future, but that's later
-    int number = std::visit(VariantToIntVisitor(), propValue);
-    auto exprBegin = splitResult.begin();
-    auto exprEnd = splitResult.end();
-
-    number = expression::evaluate(number, exprBegin, exprEnd);
-
-    std::string replaced(find.begin(), find.end());
-    while (exprBegin != exprEnd)
+    std::optional<int64_t> number;
+    if (expr)
     {
-        replaced.append(" ").append(*exprBegin++);
+        number = std::visit(VariantToInt64Visitor(), propValue);
+        if (!number)
+        {
+            lg2::error("Template {STR} does math on a property which isn't a "
+                       "number",
+                       "STR", str);
+        }
     }
-    ret = replaced;
 
-    std::string result = prefix + std::to_string(number);
-    while (exprEnd != splitResult.end())
+    if (!number)
     {
-        result.append(" ").append(*exprEnd++);
+        std::string val = std::visit(VariantToStringVisitor(), propValue);
+        iReplaceAll(str, templateName, val);
+        return false;
     }
-    str = result;
+
+    size_t exprEnd = nextItemIdx + expr->second;
+    ret = str.substr(start, exprEnd - start);
+    str = str.substr(0, start) + std::to_string(expr->first.evaluate(*number)) +
+          str.substr(exprEnd);
 
     return false;
 }
@@ -275,30 +249,7 @@ static std::optional<DBusValueVariant> templateCharReplaceLoop(
     return std::nullopt;
 }
 
-static void templateCharReplaceObj(
-    nlohmann::json::object_t& objPtr, const DBusInterface& interface,
-    const size_t index, const std::optional<std::string>& replaceStr)
-{
-    for (auto& [key, value] : objPtr)
-    {
-        templateCharReplace(value, interface, index, replaceStr);
-    }
-}
-
-static void templateCharReplaceArray(
-    nlohmann::json::array_t& arrayPtr, const DBusInterface& interface,
-    const size_t index, const std::optional<std::string>& replaceStr)
-{
-    for (auto& value : arrayPtr)
-    {
-        templateCharReplace(value, interface, index, replaceStr);
-    }
-}
-
-// @param strView: string to parse as number
-// @param strView: may be in base 10 or base 16 with '0x' prefix
-// @returns uint64_t number if it can be parsed as such
-static std::optional<uint64_t> parseAsNumber(std::string_view strView)
+std::optional<uint64_t> parseAsNumber(std::string_view strView)
 {
     if (strView.empty())
     {
@@ -348,35 +299,16 @@ static std::optional<DBusValueVariant> templateCharReplaceStr(
     return templateCharReplaceLoop(str, interface, ret);
 }
 
-// finds the template character (currently set to $) and replaces the value with
-// the field found in a dbus object i.e. $ADDRESS would get populated with the
-// ADDRESS field from a object on dbus
-std::optional<std::string> templateCharReplace(
+// Replaces the templates of a string with the properties of one interface,
+// one property at a time.
+static void templateCharReplaceSequential(
     nlohmann::json& value, const DBusInterface& interface, const size_t index,
     const std::optional<std::string>& replaceStr)
 {
-    std::optional<std::string> ret = std::nullopt;
-
-    nlohmann::json::object_t* objPtr =
-        value.get_ptr<nlohmann::json::object_t*>();
-    if (objPtr != nullptr)
-    {
-        templateCharReplaceObj(*objPtr, interface, index, replaceStr);
-        return ret;
-    }
-
-    nlohmann::json::array_t* arrPtr = value.get_ptr<nlohmann::json::array_t*>();
-    if (arrPtr != nullptr)
-    {
-        templateCharReplaceArray(*arrPtr, interface, index, replaceStr);
-        return ret;
-    }
-
     const std::string* strPtr = value.get_ptr<std::string*>();
-
     if (strPtr == nullptr)
     {
-        return ret;
+        return;
     }
 
     std::string str = *strPtr;
@@ -386,7 +318,7 @@ std::optional<std::string> templateCharReplace(
     if (exactVariant.has_value())
     {
         std::visit([&value](auto&& val) { value = val; }, *exactVariant);
-        return ret;
+        return;
     }
 
     const std::optional<uint64_t> optNum = parseAsNumber(str);
@@ -398,8 +330,97 @@ std::optional<std::string> templateCharReplace(
     {
         value = str;
     }
+}
+
+static void templateCharReplaceValue(
+    nlohmann::json& value, const TemplateProperties& properties,
+    const TemplatePlans& plans, const std::optional<std::string>& replaceStr)
+{
+    nlohmann::json::object_t* objPtr =
+        value.get_ptr<nlohmann::json::object_t*>();
+    if (objPtr != nullptr)
+    {
+        for (auto& [key, nextLayer] : *objPtr)
+        {
+            templateCharReplaceValue(nextLayer, properties, plans, replaceStr);
+        }
+        return;
+    }
+
+    nlohmann::json::array_t* arrPtr = value.get_ptr<nlohmann::json::array_t*>();
+    if (arrPtr != nullptr)
+    {
+        for (auto& nextLayer : *arrPtr)
+        {
+            templateCharReplaceValue(nextLayer, properties, plans, replaceStr);
+        }
+        return;
+    }
+
+    const std::string* strPtr = value.get_ptr<std::string*>();
+    if (strPtr == nullptr || properties.interfaces().empty())
+    {
+        return;
+    }
+
+    if (!replaceStr)
+    {
+        if (strPtr->find(templateChar) == std::string::npos)
+        {
+            const std::optional<uint64_t> optNum = parseAsNumber(*strPtr);
+            if (optNum.has_value())
+            {
+                value = optNum.value();
+            }
+            return;
+        }
+
+        const TemplatePlan* plan = plans.find(*strPtr);
+        std::optional<TemplatePlan> compiled;
+        if (plan == nullptr)
+        {
+            plan = &compiled.emplace(*strPtr);
+        }
+        if (plan->expand(properties, value))
+        {
+            return;
+        }
+    }
 
-    return ret;
+    for (const DBusInterface* interface : properties.interfaces())
+    {
+        if (!value.is_string())
+        {
+            break;
+        }
+        templateCharReplaceSequential(value, *interface, properties.index(),
+                                      replaceStr);
+    }
+}
+
+std::optional<std::string> templateCharReplace(
+    nlohmann::json& value, const TemplateProperties& properties,
+    const TemplatePlans& plans, const std::optional<std::string>& replaceStr,
+    bool handleLeftOver)
+{
+    templateCharReplaceValue(value, properties, plans, replaceStr);
+    if (handleLeftOver)
+    {
+        handleLeftOverTemplateVars(value);
+    }
+    return std::nullopt;
+}
+
+// finds the template character (currently set to $) and replaces the value with
+// the field found in a dbus object i.e. $ADDRESS would get populated with the
+// ADDRESS field from a object on dbus
+std::optional<std::string> templateCharReplace(
+    nlohmann::json& value, const DBusInterface& interface, const size_t index,
+    const std::optional<std::string>& replaceStr)
+{
+    const TemplateProperties properties(interface, index);
+    return templateCharReplace(value, properties, TemplatePlans(), replaceStr,
+                               false);
 }
 
 sdbusplus::object_path buildInventorySystemPath(std::string& boardName,
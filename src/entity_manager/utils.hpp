@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../utils.hpp"
+#include "template_plan.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <nlohmann/json.hpp>
@@ -37,6 +38,19 @@ std::optional<std::string> templateCharReplace(
     nlohmann::json& value, const DBusInterface& interface, size_t index,
     const std::optional<std::string>& replaceStr = std::nullopt);
 
+// @brief  replaces the templates like the overloads above, with the plans
+//         compiled for the loaded configurations
+std::optional<std::string> templateCharReplace(
+    nlohmann::json& value, const TemplateProperties& properties,
+    const TemplatePlans& plans,
+    const std::optional<std::string>& replaceStr = std::nullopt,
+    bool handleLeftOver = true);
+
+// @param strView: string to parse as number
+// @param strView: may be in base 10 or base 16 with '0x' prefix
+// @returns uint64_t number if it can be parsed as such
+std::optional<uint64_t> parseAsNumber(std::string_view strView);
+
 sdbusplus::object_path buildInventorySystemPath(std::string& boardName,
                                                 const std::string& boardType);
 
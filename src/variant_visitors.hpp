@@ -2,6 +2,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 Intel Corporation
 
 #pragma once
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <variant>
@@ -19,6 +21,19 @@ struct VariantToIntVisitor
     }
 };
 
+struct VariantToInt64Visitor
+{
+    template <typename T>
+    std::optional<int64_t> operator()(const T& t) const
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            return static_cast<int64_t>(t);
+        }
+        return std::nullopt;
+    }
+};
+
 struct VariantToStringVisitor
 {
     template <typename T>
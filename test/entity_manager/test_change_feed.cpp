@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "entity_manager/change_feed.hpp"
+
+#include <gtest/gtest.h>
+
+using dbus_interface::ChangeFeed;
+using dbus_interface::ChangeType;
+
+TEST(ChangeFeed, Since)
+{
+    ChangeFeed feed(8, 100);
+    EXPECT_EQ(feed.generation(), 100U);
+    ASSERT_TRUE(feed.since(100));
+    EXPECT_TRUE(feed.since(100)->empty());
+
+    feed.record(ChangeType::added, "/board");
+    feed.record(ChangeType::added, "/board/Temp");
+    feed.record(ChangeType::updated, "/board/Temp");
+    EXPECT_EQ(feed.generation(), 103U);
+
+    auto changes = feed.since(101);
+    ASSERT_TRUE(changes);
+    ASSERT_EQ(changes->size(), 2U);
+    EXPECT_EQ((*changes)[0].generation, 102U);
+    EXPECT_EQ((*changes)[0].type, ChangeType::added);
+    EXPECT_EQ((*changes)[0].path, "/board/Temp");
+    EXPECT_EQ((*changes)[1].type, ChangeType::updated);
+
+    ASSERT_TRUE(feed.since(103));
+    EXPECT_TRUE(feed.since(103)->empty());
+}
+
+// Generations of an earlier run, which started from another base, aren't
+// mistaken for ones of this run.
+TEST(ChangeFeed, OtherRun)
+{
+    ChangeFeed feed(8, 100);
+    feed.record(ChangeType::added, "/board");
+
+    EXPECT_FALSE(feed.since(0));
+    EXPECT_FALSE(feed.since(99));
+    EXPECT_FALSE(feed.since(102));
+}
+
+TEST(ChangeFeed, Repeated)
+{
+    ChangeFeed feed(8, 0);
+    feed.record(ChangeType::added, "/board");
+    feed.record(ChangeType::added, "/board");
+    feed.record(ChangeType::removed, "/board");
+    feed.record(ChangeType::added, "/board");
+    EXPECT_EQ(feed.generation(), 3U);
+}
+
+TEST(ChangeFeed, Dropped)
+{
+    ChangeFeed feed(2, 0);
+    feed.record(ChangeType::added, "/a");
+    feed.record(ChangeType::added, "/b");
+    feed.record(ChangeType::added, "/c");
+
+    EXPECT_FALSE(feed.since(0));
+    auto changes = feed.since(1);
+    ASSERT_TRUE(changes);
+    ASSERT_EQ(changes->size(), 2U);
+    EXPECT_EQ((*changes)[0].path, "/b");
+    EXPECT_EQ((*changes)[1].path, "/c");
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "entity_manager/configuration_query.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+const nlohmann::json baseboard = nlohmann::json::parse(R"(
+{
+    "Name": "Baseboard",
+    "Type": "Board",
+    "Exposes": [
+        {"Name": "InletTemp", "Type": "TMP75", "Bus": 6},
+        {"Name": "Zone1", "Type": "Pid.Zone"},
+        {"Name": "SpareTemp", "Type": "TMP75", "Status": "disabled"}
+    ]
+}
+)");
+
+constexpr const char* board = "/xyz/openbmc_project/inventory/system/board";
+
+} // namespace
+
+// The records of the requested types are returned by the path they are
+// published at, disabled ones aren't published.
+TEST(ConfigurationQuery, FindsRecordsByType)
+{
+    nlohmann::json configuration = {{"record", baseboard}};
+    dbus_interface::ConfigurationQuery query(configuration);
+
+    std::array<std::string, 2> types = {"TMP75", "Pid.Zone"};
+    nlohmann::json found = query.find(types, 1);
+    ASSERT_EQ(found.size(), 2U);
+    EXPECT_EQ(found[std::string(board) + "/Baseboard/InletTemp"],
+              baseboard["Exposes"][0]);
+    EXPECT_EQ(found[std::string(board) + "/Baseboard/Zone1"],
+              baseboard["Exposes"][1]);
+
+    std::array<std::string, 1> unknown = {"ADC"};
+    EXPECT_TRUE(query.find(unknown, 1).empty());
+}
+
+// The index is built again for a new generation of the configuration.
+TEST(ConfigurationQuery, FollowsGenerations)
+{
+    nlohmann::json configuration = {{"record", baseboard}};
+    dbus_interface::ConfigurationQuery query(configuration);
+
+    std::array<std::string, 1> types = {"TMP75"};
+    EXPECT_EQ(query.find(types, 1).size(), 1U);
+
+    nlohmann::json riser = {
+        {"Name", "Riser"},
+        {"Exposes", {{{"Name", "RiserTemp"}, {"Type", "TMP75"}}}}};
+    configuration["other"] = riser;
+    configuration["record"]["Exposes"][0] = nullptr;
+
+    nlohmann::json found = query.find(types, 2);
+    ASSERT_EQ(found.size(), 1U);
+    EXPECT_TRUE(found.contains(
+        "/xyz/openbmc_project/inventory/system/chassis/Riser/RiserTemp"));
+}
+
+// The configuration changes before a new generation is published, records
+// which were removed or changed meanwhile aren't returned from the index.
+TEST(ConfigurationQuery, SkipsChangedRecords)
+{
+    nlohmann::json configuration = {{"record", baseboard}};
+    dbus_interface::ConfigurationQuery query(configuration);
+
+    std::array<std::string, 2> types = {"TMP75", "Pid.Zone"};
+    EXPECT_EQ(query.find(types, 1).size(), 2U);
+
+    configuration["record"]["Exposes"][0]["Type"] = "ADC";
+    configuration["record"]["Exposes"].erase(1);
+    nlohmann::json found = query.find(types, 1);
+    EXPECT_TRUE(found.empty());
+
+    configuration.erase("record");
+    EXPECT_TRUE(query.find(types, 1).empty());
+}
@@ -0,0 +1,143 @@
+#include "entity_manager/configuration_store.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class ConfigurationStoreTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        const testing::TestInfo* test =
+            testing::UnitTest::GetInstance()->current_test_info();
+        directory = std::filesystem::temp_directory_path() / test->name();
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    ConfigurationStore store() const
+    {
+        return {directory / "system.cbor", directory / "system.journal"};
+    }
+
+    std::filesystem::path directory;
+    nlohmann::json configuration = {
+        {"Board", {{"Name", "board"}, {"Exposes", {{{"Value", 1.5}}}}}}};
+};
+
+TEST_F(ConfigurationStoreTest, NothingStored)
+{
+    EXPECT_EQ(std::nullopt, store().load());
+}
+
+// The journal is replayed onto the snapshot it was started for.
+TEST_F(ConfigurationStoreTest, ReplaysJournal)
+{
+    ConfigurationStore writer = store();
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    std::vector<ConfigurationPatch> patches = {
+        {"/Board/Exposes/0/Value", 2.5}, {"/Board/Name", "renamed"}};
+    ASSERT_TRUE(writer.appendJournal(patches));
+    ASSERT_TRUE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Exposes/0/Value", 3.5}}));
+
+    configuration["Board"]["Exposes"][0]["Value"] = 3.5;
+    configuration["Board"]["Name"] = "renamed";
+    EXPECT_EQ(configuration, store().load());
+}
+
+// Removed values are removed again on replay, from objects and arrays.
+TEST_F(ConfigurationStoreTest, ReplaysRemovals)
+{
+    configuration["Other"] = {{"Name", "other"}};
+    ConfigurationStore writer = store();
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    ASSERT_TRUE(writer.appendJournal(std::vector<ConfigurationPatch>{
+        {"/Board/Exposes/0", std::nullopt},
+        {"/Other", std::nullopt},
+        {"/Missing/Name", std::nullopt}}));
+
+    configuration["Board"]["Exposes"].erase(0);
+    configuration.erase("Other");
+    std::optional<nlohmann::json> loaded = store().load();
+    EXPECT_EQ(configuration, loaded);
+    EXPECT_FALSE(loaded->contains("Other"));
+}
+
+// A new snapshot starts over with an empty journal.
+TEST_F(ConfigurationStoreTest, SnapshotReplacesJournal)
+{
+    ConfigurationStore writer = store();
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    ASSERT_TRUE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Name", "renamed"}}));
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+
+    EXPECT_EQ(configuration, store().load());
+}
+
+// Patches written partially by an interrupted append are ignored.
+TEST_F(ConfigurationStoreTest, IgnoresTornPatch)
+{
+    ConfigurationStore writer = store();
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    ASSERT_TRUE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Name", "renamed"}}));
+    const uintmax_t size =
+        std::filesystem::file_size(directory / "system.journal");
+    ASSERT_TRUE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Name", "torn"}}));
+    std::filesystem::resize_file(directory / "system.journal", size + 5);
+
+    configuration["Board"]["Name"] = "renamed";
+    EXPECT_EQ(configuration, store().load());
+}
+
+// A journal doesn't apply to a snapshot it wasn't started for, e.g. if the
+// write of the snapshot's own journal was interrupted.
+TEST_F(ConfigurationStoreTest, IgnoresJournalOfOtherSnapshot)
+{
+    ConfigurationStore writer = store();
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    ASSERT_TRUE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Name", "renamed"}}));
+    std::filesystem::copy_file(directory / "system.journal",
+                               directory / "old.journal");
+    ASSERT_TRUE(writer.writeSnapshot(configuration));
+    std::filesystem::rename(directory / "old.journal",
+                            directory / "system.journal");
+
+    EXPECT_EQ(configuration, store().load());
+}
+
+TEST_F(ConfigurationStoreTest, IgnoresCorruptSnapshot)
+{
+    ASSERT_TRUE(store().writeSnapshot(configuration));
+    std::fstream file(directory / "system.cbor",
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(20);
+    file.put('\xff');
+    file.close();
+
+    EXPECT_EQ(std::nullopt, store().load());
+}
+
+// Appending needs a snapshot written by the store, as the journal on disk
+// may belong to another one.
+TEST_F(ConfigurationStoreTest, AppendNeedsSnapshot)
+{
+    ConfigurationStore writer = store();
+    EXPECT_FALSE(writer.appendJournal(
+        std::vector<ConfigurationPatch>{{"/Board/Name", "renamed"}}));
+}
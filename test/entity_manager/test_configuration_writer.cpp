@@ -0,0 +1,143 @@
+#include "entity_manager/configuration_writer.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+class ConfigurationWriterTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        const testing::TestInfo* test =
+            testing::UnitTest::GetInstance()->current_test_info();
+        directory = std::filesystem::temp_directory_path() / test->name();
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::optional<nlohmann::json> stored() const
+    {
+        return ConfigurationStore(snapshotPath(), journalPath()).load();
+    }
+
+    std::filesystem::path snapshotPath() const
+    {
+        return directory / "system.cbor";
+    }
+
+    std::filesystem::path journalPath() const
+    {
+        return directory / "system.journal";
+    }
+
+    boost::asio::io_context io;
+    std::filesystem::path directory;
+    nlohmann::json systemConfiguration = {{"Board", {{"Value", 0}}}};
+};
+
+// Changes made within the delay are written once, with all of them.
+TEST_F(ConfigurationWriterTest, CoalescesChanges)
+{
+    ConfigurationStore store(snapshotPath(), journalPath());
+    ConfigurationWriter writer(io, systemConfiguration, 10ms, &store);
+
+    writer.schedule();
+    io.run_for(50ms);
+    writer.flush();
+    const auto journalSize = std::filesystem::file_size(journalPath());
+
+    for (int i = 0; i < 50; i++)
+    {
+        systemConfiguration["Board"]["Value"] = i;
+        writer.schedule("/Board/Value");
+    }
+    io.restart();
+    io.run_for(50ms);
+    writer.flush();
+
+    EXPECT_EQ(systemConfiguration, stored());
+    // a single patch was appended to the journal
+    const auto patchSize = std::filesystem::file_size(journalPath()) -
+                           journalSize;
+    EXPECT_GT(patchSize, 0U);
+    EXPECT_LT(patchSize, 40U);
+}
+
+// A flush writes a scheduled change without waiting for the delay.
+TEST_F(ConfigurationWriterTest, FlushWritesScheduledChange)
+{
+    ConfigurationStore store(snapshotPath(), journalPath());
+    ConfigurationWriter writer(io, systemConfiguration, 1h, &store);
+
+    writer.flush();
+    EXPECT_EQ(std::nullopt, stored());
+
+    writer.schedule();
+    writer.flush();
+    EXPECT_EQ(systemConfiguration, stored());
+}
+
+// The first change is written as a snapshot, as the journal on disk may
+// belong to the snapshot of another boot.
+TEST_F(ConfigurationWriterTest, StartsWithSnapshot)
+{
+    ConfigurationStore store(snapshotPath(), journalPath());
+    ConfigurationWriter writer(io, systemConfiguration, 1h, &store);
+
+    systemConfiguration["Board"]["Value"] = 1;
+    systemConfiguration["Other"] = "added";
+    writer.schedule("/Board/Value");
+    writer.flush();
+    EXPECT_EQ(systemConfiguration, stored());
+}
+
+// A value removed from the configuration is removed from the journal, not
+// replaced with null.
+TEST_F(ConfigurationWriterTest, JournalsRemovals)
+{
+    ConfigurationStore store(snapshotPath(), journalPath());
+    ConfigurationWriter writer(io, systemConfiguration, 1h, &store);
+    systemConfiguration["Other"] = "added";
+    writer.schedule();
+    writer.flush();
+
+    systemConfiguration.erase("Other");
+    writer.schedule("/Other");
+    writer.flush();
+    std::optional<nlohmann::json> loaded = stored();
+    EXPECT_EQ(systemConfiguration, loaded);
+    EXPECT_FALSE(loaded->contains("Other"));
+}
+
+TEST_F(ConfigurationWriterTest, DestructorFlushes)
+{
+    {
+        ConfigurationStore store(snapshotPath(), journalPath());
+        ConfigurationWriter writer(io, systemConfiguration, 1h, &store);
+        writer.schedule();
+    }
+    EXPECT_EQ(systemConfiguration, stored());
+}
+
+TEST_F(ConfigurationWriterTest, NotPersisted)
+{
+    ConfigurationWriter writer(io, systemConfiguration, 1ms, nullptr);
+    writer.schedule();
+    writer.schedule("/Board/Value");
+    io.run_for(10ms);
+    writer.flush();
+    EXPECT_FALSE(std::filesystem::exists(snapshotPath()));
+}
@@ -176,6 +176,66 @@ TEST(TemplateCharReplace, multiMath)
     EXPECT_EQ(expected, j["foo"]);
 }
 
+TEST(TemplateCharReplace, leftToRight)
+{
+    nlohmann::json j = {{"foo", "$bus - 1 % 2 * 4 + 3"}};
+    DBusInterface data;
+    data["BUS"] = 6;
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = 7;
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, parentheses)
+{
+    nlohmann::json j = {{"foo", "fan $bus * (2 + 1) - (0x10 / 4) rpm"}};
+    DBusInterface data;
+    data["BUS"] = 5;
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = "fan 11 rpm";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, mathOn64Bits)
+{
+    nlohmann::json j = {{"foo", "$ADDRESS * 1024 sensor"}};
+    DBusInterface data;
+    data["ADDRESS"] = uint64_t{0x100000000};
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = "4398046511104 sensor";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, divideByZero)
+{
+    nlohmann::json j = {{"foo", "$TEST / 2 / 0"}};
+    DBusInterface data;
+    data["TEST"] = 8;
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = "4 / 0";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, mathOnString)
+{
+    nlohmann::json j = {{"foo", "$TEST + 1"}};
+    DBusInterface data;
+    data["TEST"] = std::string("abc");
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = "abc + 1";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
 TEST(TemplateCharReplace, twoReplacements)
 {
     nlohmann::json j = {{"foo", "$FOO $BAR"}};
@@ -299,6 +359,77 @@ TEST(TemplateCharReplace, leftOverTemplateVars)
     EXPECT_EQ(expected, j["foo"]);
 }
 
+TEST(TemplateCharReplace, shorterPropertyFirst)
+{
+    nlohmann::json j = {{"foo", "$BusNumber"}};
+    DBusInterface data;
+    data["Bus"] = 2;
+    data["BusNumber"] = 7;
+
+    em_utils::templateCharReplace(j, data, 0);
+
+    nlohmann::json expected = "2Number";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, numericStrOnFirstInterface)
+{
+    nlohmann::json j = {{"foo", "$SERIAL"}};
+    DBusObject object;
+    object["A"]["SERIAL"] = std::string("1234");
+    object["B"]["OTHER"] = std::string("other");
+
+    em_utils::templateCharReplace(j, object, 0);
+
+    nlohmann::json expected = 1234;
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, mathWithTrailingText)
+{
+    nlohmann::json j = {{"foo", "$index sensor $bus + 1 on  board"}};
+    DBusObject object;
+    object["A"]["BUS"] = 4;
+
+    em_utils::templateCharReplace(j, object, 3);
+
+    nlohmann::json expected = "3 sensor 5 on  board";
+    EXPECT_EQ(expected, j["foo"]);
+}
+
+TEST(TemplateCharReplace, compiledPlans)
+{
+    nlohmann::json configuration = {
+        {"Name", "$PRODUCT_PRODUCT_NAME $index"},
+        {"Exposes",
+         {{{"Address", "$ADDRESS"}, {"Bus", "$bus"}, {"Index", "$index - 1"}},
+          {{"Name", "fixed"}, {"Address", "0x4c"}}}}};
+    em_utils::TemplatePlans plans;
+    plans.add(configuration);
+
+    DBusObject object;
+    object["xyz.openbmc_project.FruDevice"]["ADDRESS"] = uint32_t{80};
+    object["xyz.openbmc_project.FruDevice"]["BUS"] = uint32_t{9};
+    object["xyz.openbmc_project.FruDevice"]["PRODUCT_PRODUCT_NAME"] =
+        std::string("Board");
+    const em_utils::TemplateProperties properties(object, 2);
+
+    nlohmann::json expanded = configuration;
+    em_utils::templateCharReplace(expanded, properties, plans);
+
+    nlohmann::json expected = {
+        {"Name", "Board 2"},
+        {"Exposes",
+         {{{"Address", 80}, {"Bus", 9}, {"Index", 1}},
+          {{"Name", "fixed"}, {"Address", 76}}}}};
+    EXPECT_EQ(expected, expanded);
+
+    // same as without the plans
+    nlohmann::json uncompiled = configuration;
+    em_utils::templateCharReplace(uncompiled, object, 2);
+    EXPECT_EQ(expected, uncompiled);
+}
+
 TEST(HandleLeftOverTemplateVars, replaceLeftOverTemplateVar)
 {
     nlohmann::json j = {{"foo", "the Test $TEST is $TESTED"}};
@@ -0,0 +1,61 @@
+#include "entity_manager/event_coalescer.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+using Clock = scan::EventCoalescer::Clock;
+
+// An isolated event is handled after the short quiet delay.
+TEST(EventCoalescer, IsolatedEventUsesQuietDelay)
+{
+    scan::EventCoalescer coalescer(20ms, 500ms, 2000ms);
+    Clock::time_point now{};
+
+    EXPECT_EQ(coalescer.eventReceived(now), 20ms);
+}
+
+// Events following each other closely are batched with the burst delay.
+TEST(EventCoalescer, BurstUsesBurstDelay)
+{
+    scan::EventCoalescer coalescer(20ms, 500ms, 2000ms);
+    Clock::time_point now{};
+
+    coalescer.eventReceived(now);
+    EXPECT_EQ(coalescer.eventReceived(now + 10ms), 500ms);
+}
+
+// A steady trickle of events cannot postpone the scan past the latency bound.
+TEST(EventCoalescer, TrickleIsBoundedByMaxLatency)
+{
+    scan::EventCoalescer coalescer(20ms, 500ms, 2000ms);
+    Clock::time_point start{};
+
+    EXPECT_EQ(coalescer.eventReceived(start), 20ms);
+    EXPECT_EQ(coalescer.eventReceived(start + 400ms), 500ms);
+    EXPECT_EQ(coalescer.eventReceived(start + 800ms), 500ms);
+    EXPECT_EQ(coalescer.eventReceived(start + 1200ms), 500ms);
+    EXPECT_EQ(coalescer.eventReceived(start + 1600ms), 400ms);
+    EXPECT_EQ(coalescer.eventReceived(start + 2000ms), 0ms);
+}
+
+// Starting a scan reports the latency and the number of coalesced events.
+TEST(EventCoalescer, ScanStartedReportsStatistics)
+{
+    scan::EventCoalescer coalescer(20ms, 500ms, 2000ms);
+    Clock::time_point start{};
+
+    coalescer.eventReceived(start);
+    coalescer.eventReceived(start + 100ms);
+    coalescer.eventReceived(start + 200ms);
+
+    EXPECT_EQ(coalescer.scanStarted(start + 700ms), 700ms);
+    EXPECT_EQ(coalescer.coalescedEvents(), 2U);
+    EXPECT_EQ(coalescer.lastLatency(), 700ms);
+
+    // the latency bound starts over for the next batch of events
+    EXPECT_EQ(coalescer.eventReceived(start + 3000ms), 20ms);
+    EXPECT_EQ(coalescer.scanStarted(start + 3020ms), 20ms);
+    EXPECT_EQ(coalescer.coalescedEvents(), 2U);
+}
@@ -0,0 +1,51 @@
+#include "entity_manager/expose_index.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using Location = scan::ExposeIndex::Location;
+
+// Exposes are found by name in the order of the system configuration, and
+// entries without a name are skipped.
+TEST(ExposeIndex, FindsExposesInOrder)
+{
+    nlohmann::json systemConfiguration = {
+        {"B", {{"Exposes", {{{"Name", "psu"}}, nullptr, {{"Name", "fan"}}}}}},
+        {"A", {{"Exposes", {{{"Name", "fan"}}}}}},
+        {"C", {{"Name", "no exposes"}}}};
+    scan::ExposeIndex index(systemConfiguration);
+
+    EXPECT_EQ((std::set<Location>{{"A", 0}, {"B", 2}}), index.find("fan"));
+    EXPECT_EQ((std::set<Location>{{"B", 0}}), index.find("psu"));
+    EXPECT_TRUE(index.find("missing").empty());
+}
+
+// Records inserted or replaced after the index was built are re-indexed.
+TEST(ExposeIndex, RecordChanged)
+{
+    nlohmann::json systemConfiguration = {
+        {"A", {{"Exposes", {{{"Name", "fan"}}}}}}};
+    scan::ExposeIndex index(systemConfiguration);
+    EXPECT_EQ((std::set<Location>{{"A", 0}}), index.find("fan"));
+
+    systemConfiguration["A"]["Exposes"] = {{{"Name", "psu"}}};
+    systemConfiguration["B"] = {{"Exposes", {{{"Name", "fan"}}}}};
+    index.recordChanged("A");
+    index.recordChanged("B");
+
+    EXPECT_EQ((std::set<Location>{{"B", 0}}), index.find("fan"));
+    EXPECT_EQ((std::set<Location>{{"A", 0}}), index.find("psu"));
+
+    systemConfiguration.erase("B");
+    index.recordChanged("B");
+    EXPECT_TRUE(index.find("fan").empty());
+
+    // changes made behind the index's back are picked up once invalidated
+    systemConfiguration["C"] = {{"Exposes", {{{"Name", "fan"}}}}};
+    index.invalidate();
+    EXPECT_EQ((std::set<Location>{{"C", 0}}), index.find("fan"));
+}
@@ -0,0 +1,68 @@
+#include "entity_manager/expose_property_types.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+using dbus_interface::ExposeProperty;
+using dbus_interface::exposePropertyTypes;
+using dbus_interface::PropertyType;
+
+namespace
+{
+
+const ExposeProperty* findProperty(std::span<const ExposeProperty> properties,
+                                   std::string_view name)
+{
+    auto found = std::ranges::find(properties, name, &ExposeProperty::name);
+    return found == properties.end() ? nullptr : &*found;
+}
+
+} // namespace
+
+// Properties the schema pins the type of are in the table, those which may
+// have different types aren't.
+TEST(ExposePropertyTypes, TypesFromSchema)
+{
+    std::span<const ExposeProperty> properties = exposePropertyTypes("TMP75");
+    ASSERT_FALSE(properties.empty());
+    EXPECT_TRUE(std::ranges::is_sorted(properties, {}, &ExposeProperty::name));
+
+    const ExposeProperty* address = findProperty(properties, "Address");
+    ASSERT_NE(nullptr, address);
+    EXPECT_EQ(PropertyType::string, address->type);
+    EXPECT_FALSE(address->array);
+
+    const ExposeProperty* labels = findProperty(properties, "Labels");
+    ASSERT_NE(nullptr, labels);
+    EXPECT_EQ(PropertyType::string, labels->type);
+    EXPECT_TRUE(labels->array);
+
+    const ExposeProperty* cpuRequired = findProperty(properties, "CPURequired");
+    ASSERT_NE(nullptr, cpuRequired);
+    EXPECT_EQ(PropertyType::uint64, cpuRequired->type);
+
+    // ["string", "number"]
+    EXPECT_EQ(nullptr, findProperty(properties, "Bus"));
+    // not necessarily a whole number
+    EXPECT_EQ(nullptr, findProperty(properties, "PollRate"));
+    // published as interfaces of their own
+    EXPECT_EQ(nullptr, findProperty(properties, "Thresholds"));
+}
+
+TEST(ExposePropertyTypes, NestedObjects)
+{
+    std::span<const ExposeProperty> properties =
+        exposePropertyTypes("TMP75.Thresholds");
+    const ExposeProperty* direction = findProperty(properties, "Direction");
+    ASSERT_NE(nullptr, direction);
+    EXPECT_EQ(PropertyType::string, direction->type);
+}
+
+TEST(ExposePropertyTypes, UnknownType)
+{
+    EXPECT_TRUE(exposePropertyTypes("NotARecordType").empty());
+    EXPECT_TRUE(exposePropertyTypes("").empty());
+}
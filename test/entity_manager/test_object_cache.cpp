@@ -0,0 +1,125 @@
+#include "entity_manager/object_cache.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr const char* fruPath = "/xyz/openbmc_project/FruDevice/1_50";
+constexpr const char* fruIface = "xyz.openbmc_project.FruDevice";
+constexpr const char* fruService = "xyz.openbmc_project.FruDevice";
+
+void fillCache(scan::ObjectCache& cache)
+{
+    MapperGetSubTreeResponse objects;
+    objects[fruPath][fruIface]["BUS"] = uint32_t{1};
+    scan::FetchedInterfaces fetched;
+    fetched[fruPath][fruIface] = fruService;
+
+    cache.beginScan();
+    cache.update(objects, fetched);
+}
+
+} // namespace
+
+// Objects are only served for the service they were fetched from.
+TEST(ObjectCache, FindMatchesService)
+{
+    scan::ObjectCache cache;
+    fillCache(cache);
+
+    const DBusInterface* found = cache.find(fruPath, fruIface, fruService);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->at("BUS"), DBusValueVariant(uint32_t{1}));
+    EXPECT_EQ(cache.find(fruPath, fruIface, "com.example.Other"), nullptr);
+    EXPECT_TRUE(cache.hasService(fruService));
+}
+
+// A signal about the object or its service drops it.
+TEST(ObjectCache, Invalidation)
+{
+    scan::ObjectCache cache;
+    fillCache(cache);
+    cache.invalidatePath(fruPath);
+    EXPECT_EQ(cache.find(fruPath, fruIface, fruService), nullptr);
+
+    fillCache(cache);
+    EXPECT_FALSE(cache.invalidateService("com.example.Other"));
+    EXPECT_TRUE(cache.invalidateService(fruService));
+    EXPECT_EQ(cache.find(fruPath, fruIface, fruService), nullptr);
+    EXPECT_FALSE(cache.hasService(fruService));
+}
+
+// An object invalidated while a scan runs may have been fetched before the
+// change, the scan's result must not bring it back.
+TEST(ObjectCache, InvalidationDuringScan)
+{
+    scan::ObjectCache cache;
+
+    MapperGetSubTreeResponse objects;
+    objects[fruPath][fruIface]["BUS"] = uint32_t{1};
+    scan::FetchedInterfaces fetched;
+    fetched[fruPath][fruIface] = fruService;
+
+    cache.beginScan();
+    cache.invalidatePath(fruPath);
+    cache.update(objects, fetched);
+    EXPECT_EQ(cache.find(fruPath, fruIface, fruService), nullptr);
+}
+
+// Objects of a service leaving the bus are dropped without making the cache
+// incomplete, other invalidations have the objects fetched again.
+TEST(ObjectCache, RemovedServiceKeepsCacheComplete)
+{
+    scan::ObjectCache cache;
+    EXPECT_FALSE(cache.complete());
+    fillCache(cache);
+    EXPECT_TRUE(cache.complete());
+
+    MapperGetSubTreeResponse objects;
+    scan::FetchedInterfaces fetched;
+    cache.restore(objects, fetched);
+    EXPECT_EQ(objects[fruPath][fruIface].at("BUS"),
+              DBusValueVariant(uint32_t{1}));
+    EXPECT_EQ(fetched[fruPath][fruIface], fruService);
+
+    EXPECT_TRUE(cache.removeService(fruService));
+    EXPECT_TRUE(cache.complete());
+    objects.clear();
+    fetched.clear();
+    cache.restore(objects, fetched);
+    EXPECT_TRUE(objects.empty());
+    EXPECT_TRUE(fetched.empty());
+
+    fillCache(cache);
+    EXPECT_FALSE(cache.invalidateService("com.example.Other"));
+    EXPECT_TRUE(cache.complete());
+    EXPECT_TRUE(cache.invalidateService(fruService));
+    EXPECT_FALSE(cache.complete());
+
+    fillCache(cache);
+    cache.invalidatePath(fruPath);
+    EXPECT_FALSE(cache.complete());
+}
+
+// A scan that raced with an invalidation leaves the cache incomplete.
+TEST(ObjectCache, InvalidationDuringScanLeavesIncomplete)
+{
+    scan::ObjectCache cache;
+    MapperGetSubTreeResponse objects;
+    objects[fruPath][fruIface]["BUS"] = uint32_t{1};
+    scan::FetchedInterfaces fetched;
+    fetched[fruPath][fruIface] = fruService;
+
+    cache.beginScan();
+    cache.invalidatePath("/xyz/openbmc_project/FruDevice/2_50");
+    cache.update(objects, fetched);
+    EXPECT_FALSE(cache.complete());
+
+    cache.beginScan();
+    cache.removeService("com.example.Other");
+    cache.update(objects, fetched);
+    EXPECT_TRUE(cache.complete());
+}
@@ -1,8 +1,12 @@
 #include "entity_manager/perform_scan.hpp"
+#include "entity_manager/record_name.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <flat_set>
+#include <functional>
 #include <string>
+#include <variant>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -32,3 +36,126 @@ TEST(ParseProbeCommand, ReturnsEmptyOnNonStringElement)
     json probe = json::array({"FOUND('A')", 42});
     EXPECT_TRUE(scan::detail::parseProbeCommand(probe).empty());
 }
+
+// Objects are grouped under the first three segments of their path, roots
+// nested in other roots are dropped.
+TEST(DeriveProbeRoots, GroupsObjectsByPathPrefix)
+{
+    MapperGetSubTreeResponse objects;
+    objects["/xyz/openbmc_project/FruDevice/1_50"] = {};
+    objects["/xyz/openbmc_project/FruDevice/2_51"] = {};
+    objects["/xyz/openbmc_project/inventory/system/board/Board"] = {};
+    objects["/xyz/openbmc_project/inventory"] = {};
+
+    EXPECT_EQ(scan::detail::deriveProbeRoots(objects),
+              (std::flat_set<std::string, std::less<>>{
+                  "/xyz/openbmc_project"}));
+
+    objects.erase("/xyz/openbmc_project/inventory");
+    EXPECT_EQ(scan::detail::deriveProbeRoots(objects),
+              (std::flat_set<std::string, std::less<>>{
+                  "/xyz/openbmc_project/FruDevice",
+                  "/xyz/openbmc_project/inventory"}));
+}
+
+// Only the root itself and paths beneath it are covered, not siblings sharing
+// a prefix.
+TEST(DeriveProbeRoots, PathUnderRoots)
+{
+    std::flat_set<std::string, std::less<>> roots{
+        "/xyz/openbmc_project/FruDevice"};
+
+    EXPECT_TRUE(scan::detail::pathUnderRoots(
+        roots, "/xyz/openbmc_project/FruDevice"));
+    EXPECT_TRUE(scan::detail::pathUnderRoots(
+        roots, "/xyz/openbmc_project/FruDevice/1_50"));
+    EXPECT_FALSE(scan::detail::pathUnderRoots(
+        roots, "/xyz/openbmc_project/FruDevices"));
+    EXPECT_FALSE(scan::detail::pathUnderRoots(roots, "/com/example/Fru"));
+    EXPECT_TRUE(scan::detail::pathUnderRoots({"/"}, "/com/example/Fru"));
+}
+
+// The record hasher is XXH64, fed in pieces or at once.
+TEST(RecordHasher, MatchesXxh64)
+{
+    EXPECT_EQ(scan::RecordHasher().digest(), 0xEF46DB3751D8E999ULL);
+
+    scan::RecordHasher abc;
+    abc.update("abc");
+    EXPECT_EQ(abc.digest(), 0x44BC2CF5AD770999ULL);
+
+    std::string bytes;
+    for (int i = 0; i < 100; i++)
+    {
+        bytes.push_back(static_cast<char>(i));
+    }
+    scan::RecordHasher whole;
+    whole.update(bytes);
+    EXPECT_EQ(whole.digest(), 0x6AC1E58032166597ULL);
+
+    scan::RecordHasher pieces;
+    std::string_view rest(bytes);
+    for (size_t size : {1, 30, 2, 40, 27})
+    {
+        pieces.update(rest.substr(0, size));
+        rest.remove_prefix(size);
+    }
+    EXPECT_EQ(pieces.digest(), whole.digest());
+}
+
+// Record names don't depend on the build, so records persisted by an earlier
+// boot are found again.
+TEST(RecordName, IsStable)
+{
+    DBusInterface probe{{"ADDRESS", uint64_t{80}}, {"BUS", uint64_t{3}}};
+    EXPECT_EQ(scan::recordName(probe, "Foo"), "387383bb02e4bb91");
+    EXPECT_EQ(scan::recordName({}, "Foo"), "Foo");
+}
+
+// The type of a property is part of the name, as are the bounds of strings.
+TEST(RecordName, EncodesTypesAndSizes)
+{
+    EXPECT_NE(scan::recordName({{"BUS", uint64_t{3}}}, "Foo"),
+              scan::recordName({{"BUS", int64_t{3}}}, "Foo"));
+    EXPECT_NE(
+        scan::recordName({{"A", std::vector<std::string>{"a", "bc"}}}, "Foo"),
+        scan::recordName({{"A", std::vector<std::string>{"ab", "c"}}}, "Foo"));
+    EXPECT_NE(scan::recordName({{"BUS", uint64_t{3}}}, "Foo"),
+              scan::recordName({{"BUS", uint64_t{3}}}, "Bar"));
+}
+
+// Only names made by std::to_string() of a hash are looked up again by their
+// legacy name.
+TEST(RecordName, RecognizesLegacyNames)
+{
+    DBusInterface probe{{"BUS", uint64_t{3}}};
+    EXPECT_EQ(scan::legacyRecordName(probe, "Foo"),
+              std::to_string(std::hash<std::string>{}(R"(Foo["BUS",3])")));
+    EXPECT_TRUE(scan::isLegacyRecordName("12919170362713307212"));
+    EXPECT_TRUE(scan::isLegacyRecordName("837281982"));
+    EXPECT_FALSE(scan::isLegacyRecordName("1291917036271330"));
+    EXPECT_FALSE(scan::isLegacyRecordName(scan::recordName(probe, "Foo")));
+    EXPECT_FALSE(scan::isLegacyRecordName("Foo"));
+    EXPECT_FALSE(scan::isLegacyRecordName(""));
+}
+
+// Legacy names hash the values of every property, which the projection a scan
+// probes with replaces by digests unless a configuration refers to them.
+TEST(RecordName, LegacyNameOfProjectedProperties)
+{
+    DBusInterface all{{"PRODUCT", std::string("Board")},
+                      {"SERIAL", std::string("1234")},
+                      {"BUS", uint32_t{3}}};
+    const std::string legacy = std::to_string(std::hash<std::string>{}(
+        R"(Foo["BUS",3,"PRODUCT","Board","SERIAL","1234"])"));
+
+    scan::PropertyProjection projection;
+    projection.addProbe("xyz.openbmc_project.FruDevice({'PRODUCT': 'B.*'})");
+    DBusInterface projected = all;
+    projection.project(projected);
+
+    EXPECT_EQ(projected.at("PRODUCT"), all.at("PRODUCT"));
+    EXPECT_TRUE(std::holds_alternative<uint64_t>(projected.at("BUS")));
+    EXPECT_NE(scan::legacyRecordName(projected, "Foo"), legacy);
+    EXPECT_EQ(scan::legacyRecordName(all, "Foo"), legacy);
+}
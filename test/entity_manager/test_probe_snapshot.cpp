@@ -0,0 +1,35 @@
+#include "entity_manager/probe_snapshot.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Properties survive a round trip with the exact type they had on D-Bus.
+TEST(ProbeSnapshot, RoundTripKeepsTypes)
+{
+    scan::ProbeSnapshot snapshot;
+    DBusInterface& fru =
+        snapshot.objects["/xyz/openbmc_project/FruDevice/1_50"]
+                        ["xyz.openbmc_project.FruDevice"];
+    fru["BOARD_PRODUCT_NAME"] = std::string("Board");
+    fru["BUS"] = uint32_t{1};
+    fru["ADDRESS"] = uint32_t{0x50};
+    fru["OFFSET"] = int64_t{-1};
+    fru["PRESENT"] = true;
+    fru["RAW"] = std::vector<uint8_t>{1, 2, 3};
+
+    auto decoded = scan::ProbeSnapshot::decode(snapshot.encode());
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoded->objects, snapshot.objects);
+}
+
+// Data that is not a snapshot is rejected.
+TEST(ProbeSnapshot, DecodeRejectsGarbage)
+{
+    std::vector<uint8_t> garbage{0xff, 0x00, 0x12};
+    EXPECT_FALSE(scan::ProbeSnapshot::decode(garbage));
+    EXPECT_FALSE(scan::ProbeSnapshot::decode({}));
+}
+
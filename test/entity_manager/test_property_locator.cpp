@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "entity_manager/property_locator.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+using dbus_interface::fromJson;
+using dbus_interface::PropertyLocator;
+
+// The properties are found through the object they are members of, for as
+// long as the configuration has them.
+TEST(PropertyLocator, FindsProperties)
+{
+    nlohmann::json configuration = {
+        {"record",
+         {{"Name", "Baseboard"},
+          {"Exposes",
+           {{{"Name", "Inlet"},
+             {"Thresholds", {{{"Value", 40}}, {{"Value", 50}}}}}}}}}};
+
+    auto exposes = PropertyLocator::locate("/record/Exposes/0");
+    ASSERT_EQ(exposes->size(), 3U);
+
+    PropertyLocator name(exposes, "Name");
+    ASSERT_NE(name.find(configuration), nullptr);
+    EXPECT_EQ(*name.find(configuration), "Inlet");
+    EXPECT_EQ(name.pointer(), "/record/Exposes/0/Name");
+
+    PropertyLocator threshold(
+        PropertyLocator::locate("/record/Exposes/0/Thresholds/1"), "Value");
+    ASSERT_NE(threshold.find(configuration), nullptr);
+    *threshold.find(configuration) = 55;
+    EXPECT_EQ(configuration["record"]["Exposes"][0]["Thresholds"][1]["Value"],
+              55);
+
+    EXPECT_EQ(PropertyLocator(exposes, "Type").find(configuration), nullptr);
+    EXPECT_EQ(PropertyLocator(PropertyLocator::locate("/record/Exposes/1"),
+                              "Name")
+                  .find(configuration),
+              nullptr);
+    EXPECT_EQ(PropertyLocator(PropertyLocator::locate("/record/Exposes/x"),
+                              "Name")
+                  .find(configuration),
+              nullptr);
+
+    configuration["record"]["Exposes"][0] = nullptr;
+    EXPECT_EQ(name.find(configuration), nullptr);
+}
+
+// Reference tokens are escaped as in JSON pointers.
+TEST(PropertyLocator, EscapedTokens)
+{
+    nlohmann::json configuration = {{"a/b", {{"c~d", true}}}};
+    PropertyLocator locator(PropertyLocator::locate("/a~1b"), "c~d");
+    ASSERT_NE(locator.find(configuration), nullptr);
+    EXPECT_EQ(locator.pointer(), "/a~1b/c~0d");
+    EXPECT_EQ(configuration.at(nlohmann::json::json_pointer(locator.pointer())),
+              true);
+}
+
+// Values are converted to the type they were published with.
+TEST(PropertyLocator, FromJson)
+{
+    double number = 0;
+    EXPECT_TRUE(fromJson(nlohmann::json(3), number));
+    EXPECT_EQ(number, 3.0);
+    EXPECT_FALSE(fromJson(nlohmann::json("3"), number));
+
+    bool flag = false;
+    EXPECT_FALSE(fromJson(nlohmann::json(1), flag));
+    EXPECT_TRUE(fromJson(nlohmann::json(true), flag));
+    EXPECT_TRUE(flag);
+
+    std::string str;
+    EXPECT_TRUE(fromJson(nlohmann::json("Inlet"), str));
+    EXPECT_EQ(str, "Inlet");
+
+    std::vector<uint64_t> values;
+    EXPECT_TRUE(fromJson(nlohmann::json{1, "2", 3}, values));
+    EXPECT_EQ(values, (std::vector<uint64_t>{1, 3}));
+    EXPECT_FALSE(fromJson(nlohmann::json(1), values));
+}
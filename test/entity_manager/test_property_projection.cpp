@@ -0,0 +1,80 @@
+#include "entity_manager/property_projection.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// FNV-1a of the bytes of a GetAll reply value digestValue() goes over
+uint64_t fnv(std::string_view bytes)
+{
+    uint64_t digest = 0xcbf29ce484222325;
+    for (char c : bytes)
+    {
+        digest ^= static_cast<unsigned char>(c);
+        digest *= 0x100000001b3;
+    }
+    return digest;
+}
+
+} // namespace
+
+// Properties matched by a probe are referenced by their exact name.
+TEST(PropertyProjection, ProbeProperties)
+{
+    scan::PropertyProjection projection;
+    projection.addProbe(
+        "xyz.openbmc_project.FruDevice({'BOARD_PRODUCT_NAME': 'Board.*'})");
+
+    EXPECT_TRUE(projection.referenced("BOARD_PRODUCT_NAME"));
+    EXPECT_FALSE(projection.referenced("board_product_name"));
+    EXPECT_FALSE(projection.referenced("BOARD_SERIAL_NUMBER"));
+}
+
+// Templates match case-insensitively and on a prefix of the identifier
+// following the '$', like the template substitution does.
+TEST(PropertyProjection, TemplateProperties)
+{
+    scan::PropertyProjection projection;
+    projection.addTemplates(nlohmann::json::parse(R"(
+        {
+            "Name": "$bus Board",
+            "Exposes": [{"Address": "$ADDRESS", "Bus": "$BUSNUM + 1"}]
+        }
+    )"));
+
+    EXPECT_TRUE(projection.referenced("BUS"));
+    EXPECT_TRUE(projection.referenced("ADDRESS"));
+    EXPECT_TRUE(projection.referenced("BUSNUM"));
+    EXPECT_FALSE(projection.referenced("BUSNUMBER"));
+    EXPECT_FALSE(projection.referenced("PRODUCT"));
+}
+
+// Properties decoded in full are projected to what decoding the reply with the
+// projection yields: the value of referenced ones, otherwise the digest of the
+// variant in the message, i.e. of its signature and contents.
+TEST(PropertyProjection, Project)
+{
+    scan::PropertyProjection projection;
+    projection.addProbe(
+        "xyz.openbmc_project.FruDevice({'BOARD_PRODUCT_NAME': 'Board.*'})");
+
+    DBusInterface properties{
+        {"BOARD_PRODUCT_NAME", std::string("Board")},
+        {"BOARD_SERIAL_NUMBER", std::string("abc")},
+        {"NAMES", std::vector<std::string>{"a", "bc"}}};
+    projection.project(properties);
+
+    EXPECT_EQ(properties.at("BOARD_PRODUCT_NAME"),
+              DBusValueVariant(std::string("Board")));
+    EXPECT_EQ(properties.at("BOARD_SERIAL_NUMBER"),
+              DBusValueVariant(fnv("vssabc")));
+    EXPECT_EQ(properties.at("NAMES"), DBusValueVariant(fnv("vasassasbc")));
+}
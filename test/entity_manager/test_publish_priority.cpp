@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "entity_manager/publish_priority.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+using dbus_interface::PublishPriority;
+using dbus_interface::publishPriority;
+
+// Boards exposing what the fan and power control need are critical.
+TEST(PublishPriority, FromExposedTypes)
+{
+    nlohmann::json baseboard = {
+        {"Name", "Baseboard"},
+        {"Exposes",
+         {{{"Name", "Inlet"}, {"Type", "TMP75"}},
+          {{"Name", "Zone 1"}, {"Type", "Pid.Zone"}}}}};
+    EXPECT_EQ(publishPriority(baseboard), PublishPriority::critical);
+
+    nlohmann::json dimm = {
+        {"Name", "DIMM 1"},
+        {"Exposes", {{{"Name", "DIMM 1 Temp"}, {"Type", "TMP75"}}}}};
+    EXPECT_EQ(publishPriority(dimm), PublishPriority::normal);
+
+    EXPECT_EQ(publishPriority(nlohmann::json{{"Name", "Riser"}}),
+              PublishPriority::normal);
+    EXPECT_EQ(publishPriority(nlohmann::json()), PublishPriority::normal);
+}
+
+// A record setting its priority overrides what its types imply.
+TEST(PublishPriority, Configured)
+{
+    nlohmann::json backplane = {
+        {"Name", "Backplane"},
+        {"PublishPriority", "Critical"},
+        {"Exposes", {{{"Name", "Drive 1 Temp"}, {"Type", "TMP75"}}}}};
+    EXPECT_EQ(publishPriority(backplane), PublishPriority::critical);
+
+    nlohmann::json fanBoard = {
+        {"Name", "Fan board"},
+        {"PublishPriority", "Normal"},
+        {"Exposes", {{{"Name", "Fan 1"}, {"Type", "I2CFan"}}}}};
+    EXPECT_EQ(publishPriority(fanBoard), PublishPriority::normal);
+
+    fanBoard["PublishPriority"] = "Urgent";
+    EXPECT_EQ(publishPriority(fanBoard), PublishPriority::critical);
+}
@@ -0,0 +1,41 @@
+#include "entity_manager/record_inputs.hpp"
+
+#include <gtest/gtest.h>
+
+using Input = scan::RecordInputs::Input;
+
+constexpr const char* fru = "xyz.openbmc_project.FruDevice";
+
+// Only the records templated from a property become stale when it changes.
+TEST(RecordInputs, MarksDependentRecordsStale)
+{
+    scan::RecordInputs inputs;
+    inputs.set("a",
+               {Input{"/fru/1", fru, "BUS"}, Input{"/fru/1", fru, "ADDRESS"}});
+    inputs.set("b", {Input{"/fru/2", fru, "BUS"}});
+
+    EXPECT_FALSE(inputs.changed("/fru/1", fru, "PRODUCT_SERIAL_NUMBER"));
+    EXPECT_FALSE(inputs.changed("/fru/3", fru, "BUS"));
+    EXPECT_FALSE(inputs.stale("a"));
+
+    EXPECT_TRUE(inputs.changed("/fru/1", fru, "BUS"));
+    EXPECT_TRUE(inputs.stale("a"));
+    EXPECT_FALSE(inputs.stale("b"));
+}
+
+// Instantiating a record again replaces its inputs, removing it forgets them.
+TEST(RecordInputs, SetAndRemove)
+{
+    scan::RecordInputs inputs;
+    inputs.set("a", {Input{"/fru/1", fru, "BUS"}});
+    EXPECT_TRUE(inputs.changed("/fru/1", fru, "BUS"));
+
+    inputs.set("a", {Input{"/fru/1", fru, "ADDRESS"}});
+    EXPECT_FALSE(inputs.stale("a"));
+    EXPECT_FALSE(inputs.changed("/fru/1", fru, "BUS"));
+    EXPECT_TRUE(inputs.changed("/fru/1", fru, "ADDRESS"));
+
+    inputs.remove("a");
+    EXPECT_FALSE(inputs.stale("a"));
+    EXPECT_FALSE(inputs.changed("/fru/1", fru, "ADDRESS"));
+}